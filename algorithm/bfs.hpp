@@ -0,0 +1,241 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <limits>
+#include <ranges>
+#include "shortest_path.hpp"
+#include "parallel.hpp"
+#include "../data-structure/graph.hpp"
+#include "../concepts/graph_concepts.hpp"
+
+namespace gcl
+{
+    // 重みなしグラフの幅優先探索。到達不能な頂点の距離は`std::numeric_limits<std::size_t>::max()`
+    // キューは長さ`N`の配列を先頭・末尾の添字で使う（各頂点は高々1回しか積まれない）
+    inline DijkstraResult<std::size_t> bfs(const Graph &graph, std::size_t start)
+    {
+        constexpr auto INF = std::numeric_limits<std::size_t>::max();
+        const auto n = graph.size();
+        assert(start < n);
+        std::vector<std::size_t> dist(n, INF), parent(n, npos), queue(n);
+        std::size_t head = 0, tail = 0;
+        dist[start] = 0;
+        queue[tail++] = start;
+        while (head < tail)
+        {
+            const auto v = queue[head++];
+            for (const auto &e : graph[v])
+            {
+                if (dist[e.to] != INF)
+                    continue;
+                dist[e.to] = dist[v] + 1;
+                parent[e.to] = v;
+                queue[tail++] = e.to;
+            }
+        }
+        return {start, std::move(dist), std::move(parent)};
+    }
+
+    // 辺の重みが 0 か 1 のグラフの最短経路（0-1 BFS）
+    // 重み 0 の辺で緩和した頂点を deque の先頭に、重み 1 の辺で緩和した頂点を末尾に積む
+    template <typename C>
+        requires WeightedGraph<C>
+    DijkstraResult<weight_t<C>> zero_one_bfs(const C &graph, std::size_t start)
+    {
+        using W = weight_t<C>;
+        constexpr W INF = std::numeric_limits<W>::max();
+        const auto n = std::ranges::size(graph);
+        assert(start < n);
+        std::vector<W> dist(n, INF);
+        std::vector<std::size_t> parent(n, npos);
+        std::deque<std::size_t> deque{start};
+        dist[start] = W{};
+        while (!deque.empty())
+        {
+            const auto v = deque.front();
+            deque.pop_front();
+            for (auto &&e : graph[v])
+            {
+                const auto w = static_cast<W>(e.weight);
+                assert(w == W{} || w == W{1});
+                if (chmin(dist[e.to], dist[v] + w))
+                {
+                    parent[e.to] = v;
+                    if (w == W{})
+                        deque.push_front(e.to);
+                    else
+                        deque.push_back(e.to);
+                }
+            }
+        }
+        return {start, std::move(dist), std::move(parent)};
+    }
+
+    // 方向最適化幅優先探索の各段で辺をたどる向き
+    enum class BfsDirection
+    {
+        // `alpha`と`beta`に従って段ごとに選ぶ
+        automatic,
+        // 全ての段をトップダウンで処理する
+        top_down,
+        // 全ての段をボトムアップで処理する
+        bottom_up,
+    };
+
+    struct DirectionOptimizingBfsOptions
+    {
+        // 前線から出る辺の数が未探索の辺の数の`1 / alpha`を超えたらボトムアップに切り替える
+        std::size_t alpha = 15;
+        // 前線の頂点数が頂点数の`1 / beta`を下回ったらトップダウンに戻す
+        std::size_t beta = 18;
+        // ボトムアップの段を処理するスレッド数
+        std::size_t n_threads = 1;
+        // 向きを固定する場合に指定する（性能の比較や検証用）
+        BfsDirection direction = BfsDirection::automatic;
+    };
+
+    // 方向最適化幅優先探索（Beamer et al.）
+    // 前線が小さい段は前線から辺をたどり（トップダウン）、前線が大きい段は未訪問の頂点から`reverse`の辺をたどって
+    // 前線（ビット集合）に含まれる頂点を探す（ボトムアップ）。直径の小さい大規模なグラフで辺の走査を大きく減らせる
+    // `reverse`は`graph`の全ての辺を逆向きにしたグラフ。距離は`bfs`と一致するが、親は異なることがある
+    inline DijkstraResult<std::size_t> direction_optimizing_bfs(const Graph &graph, const Graph &reverse, std::size_t start,
+                                                                DirectionOptimizingBfsOptions options = {})
+    {
+        constexpr auto INF = std::numeric_limits<std::size_t>::max();
+        constexpr std::size_t WORD = 64;
+        const auto n = graph.size();
+        assert(start < n && reverse.size() == n);
+        assert(options.alpha > 0 && options.beta > 0);
+        const auto n_words = (n + WORD - 1) / WORD;
+
+        std::vector<std::size_t> dist(n, INF), parent(n, npos);
+        // トップダウンの段の前線（頂点の列）と、ボトムアップの段の前線（ビット集合）
+        std::vector<std::size_t> frontier{start}, next;
+        std::vector<std::uint64_t> frontier_bits(n_words), next_bits(n_words), visited(n_words);
+        const auto set_bit = [](std::vector<std::uint64_t> &bits, std::size_t v)
+        { bits[v / WORD] |= std::uint64_t{1} << (v % WORD); };
+        const auto test_bit = [](const std::vector<std::uint64_t> &bits, std::size_t v)
+        { return (bits[v / WORD] >> (v % WORD) & 1) != 0; };
+
+        std::size_t unexplored_edges = 0;
+        for (const auto &edges : graph)
+            unexplored_edges += edges.size();
+        dist[start] = 0;
+        set_bit(visited, start);
+        unexplored_edges -= graph[start].size();
+
+        bool bottom_up = false;
+        std::size_t frontier_size = 1;
+        // ボトムアップの段で各スレッドが見つけた頂点の出次数の和。スレッドは段ごとに作り直さず使い回す
+        WorkerGroup workers(options.n_threads);
+        std::vector<std::size_t> found_edges(workers.size());
+        for (std::size_t level = 1; frontier_size > 0; level++)
+        {
+            // この段の向きを決め、前線の表現を切り替える
+            auto next_bottom_up = options.direction == BfsDirection::bottom_up;
+            if (options.direction == BfsDirection::automatic)
+            {
+                if (!bottom_up)
+                {
+                    std::size_t frontier_edges = 0;
+                    for (const auto v : frontier)
+                        frontier_edges += graph[v].size();
+                    next_bottom_up = frontier_edges > unexplored_edges / options.alpha;
+                }
+                else
+                    next_bottom_up = frontier_size >= n / options.beta;
+            }
+            if (next_bottom_up && !bottom_up)
+            {
+                std::ranges::fill(frontier_bits, 0);
+                for (const auto v : frontier)
+                    set_bit(frontier_bits, v);
+            }
+            else if (!next_bottom_up && bottom_up)
+            {
+                frontier.clear();
+                for (std::size_t w = 0; w < n_words; w++)
+                {
+                    for (auto bits = frontier_bits[w]; bits != 0; bits &= bits - 1)
+                        frontier.push_back(w * WORD + static_cast<std::size_t>(std::countr_zero(bits)));
+                }
+            }
+            bottom_up = next_bottom_up;
+
+            if (!bottom_up)
+            {
+                next.clear();
+                for (const auto v : frontier)
+                {
+                    for (const auto &e : graph[v])
+                    {
+                        if (test_bit(visited, e.to))
+                            continue;
+                        set_bit(visited, e.to);
+                        dist[e.to] = level;
+                        parent[e.to] = v;
+                        unexplored_edges -= graph[e.to].size();
+                        next.push_back(e.to);
+                    }
+                }
+                std::swap(frontier, next);
+                frontier_size = frontier.size();
+                continue;
+            }
+
+            // ボトムアップ：ビット集合の語ごとに独立なので、語の区間ごとに並列に処理できる
+            std::ranges::fill(found_edges, 0);
+            workers.run_blocks(n_words, 256,
+                               [&](std::size_t first, std::size_t last, std::size_t thread_id)
+                               {
+                                   // 隣り合う`found_edges`の要素への書き込みが競合しないよう、区間ごとに数えてから足す
+                                   std::size_t edges = 0;
+                                   for (auto w = first; w < last; w++)
+                                   {
+                                       std::uint64_t next_word = 0;
+                                       auto unvisited = ~visited[w];
+                                       if (w + 1 == n_words && n % WORD != 0)
+                                           unvisited &= (std::uint64_t{1} << (n % WORD)) - 1;
+                                       for (; unvisited != 0; unvisited &= unvisited - 1)
+                                       {
+                                           const auto u = w * WORD + static_cast<std::size_t>(std::countr_zero(unvisited));
+                                           for (const auto &e : reverse[u])
+                                           {
+                                               if (!test_bit(frontier_bits, e.to))
+                                                   continue;
+                                               dist[u] = level;
+                                               parent[u] = e.to;
+                                               next_word |= std::uint64_t{1} << (u % WORD);
+                                               edges += graph[u].size();
+                                               break;
+                                           }
+                                       }
+                                       next_bits[w] = next_word;
+                                   }
+                                   found_edges[thread_id] += edges;
+                               });
+            frontier_size = 0;
+            for (std::size_t w = 0; w < n_words; w++)
+            {
+                visited[w] |= next_bits[w];
+                frontier_size += static_cast<std::size_t>(std::popcount(next_bits[w]));
+            }
+            for (const auto edges : found_edges)
+                unexplored_edges -= edges;
+            std::swap(frontier_bits, next_bits);
+        }
+        return {start, std::move(dist), std::move(parent)};
+    }
+
+    // 無向グラフ（各辺を両方向に持つグラフ）に対する方向最適化幅優先探索
+    inline DijkstraResult<std::size_t> direction_optimizing_bfs(const Graph &graph, std::size_t start,
+                                                                DirectionOptimizingBfsOptions options = {})
+    {
+        return direction_optimizing_bfs(graph, graph, start, options);
+    }
+}
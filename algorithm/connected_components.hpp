@@ -0,0 +1,90 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include "parallel.hpp"
+#include "../data-structure/graph.hpp"
+#include "../data-structure/concurrent_unionfind.hpp"
+#include "../concepts/graph_concepts.hpp"
+
+namespace gcl
+{
+    namespace connected_components_detail
+    {
+        // `for_each_edge(first, last, unite)`で頂点（または辺）`[first, last)`の辺を全て`unite(u, v)`に渡す
+        template <std::signed_integral Index, class F>
+        std::vector<std::size_t> label_with(std::size_t n_vertices, std::size_t n_items, std::size_t n_threads, F &&for_each_edge)
+        {
+            constexpr std::size_t BLOCK = 1024;
+            ConcurrentUnionFind<Index> uf(n_vertices);
+            parallel_for_blocks(n_items, n_threads, BLOCK,
+                                [&](std::size_t first, std::size_t last, std::size_t)
+                                { for_each_edge(first, last, [&](std::size_t u, std::size_t v)
+                                                { uf.unite(u, v); }); });
+
+            std::vector<std::size_t> labels(n_vertices);
+            parallel_for_blocks(n_vertices, n_threads, BLOCK,
+                                [&](std::size_t first, std::size_t last, std::size_t)
+                                {
+                                    for (auto v = first; v < last; v++)
+                                        labels[v] = uf.find(v);
+                                });
+            return labels;
+        }
+
+        template <class F>
+        std::vector<std::size_t> label(std::size_t n_vertices, std::size_t n_items, std::size_t n_threads, F &&for_each_edge)
+        {
+            // 頂点数が収まる限り 32bit 版を使う
+            if (n_vertices <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+                return label_with<std::int32_t>(n_vertices, n_items, n_threads, for_each_edge);
+            return label_with<std::int64_t>(n_vertices, n_items, n_threads, for_each_edge);
+        }
+    }
+
+    // 辺集合`edges`（向きは無視する）による連結成分を`n_threads`本のスレッドで求める
+    // 返り値`labels[v]`は`v`を含む連結成分の最小の頂点番号
+    template <class W>
+    std::vector<std::size_t> parallel_connected_components(std::size_t n_vertices, const std::vector<UWEdge<W>> &edges,
+                                                           std::size_t n_threads = default_thread_count())
+    {
+        return connected_components_detail::label(n_vertices, edges.size(), n_threads,
+                                                  [&](std::size_t first, std::size_t last, auto &&unite)
+                                                  {
+                                                      for (auto i = first; i < last; i++)
+                                                          unite(edges[i].from, edges[i].to);
+                                                  });
+    }
+
+    // グラフ`graph`の（辺の向きを無視した）連結成分を`n_threads`本のスレッドで求める
+    // 返り値`labels[v]`は`v`を含む連結成分の最小の頂点番号
+    template <WeightedGraph G>
+    std::vector<std::size_t> parallel_connected_components(const G &graph, std::size_t n_threads = default_thread_count())
+    {
+        return connected_components_detail::label(std::ranges::size(graph), std::ranges::size(graph), n_threads,
+                                                  [&](std::size_t first, std::size_t last, auto &&unite)
+                                                  {
+                                                      for (auto u = first; u < last; u++)
+                                                      {
+                                                          for (const auto &e : graph[u])
+                                                              unite(u, static_cast<std::size_t>(e.to));
+                                                      }
+                                                  });
+    }
+
+    // 重みなしグラフ版
+    inline std::vector<std::size_t> parallel_connected_components(const Graph &graph, std::size_t n_threads = default_thread_count())
+    {
+        return connected_components_detail::label(graph.size(), graph.size(), n_threads,
+                                                  [&](std::size_t first, std::size_t last, auto &&unite)
+                                                  {
+                                                      for (auto u = first; u < last; u++)
+                                                      {
+                                                          for (const auto &e : graph[u])
+                                                              unite(u, e.to);
+                                                      }
+                                                  });
+    }
+}
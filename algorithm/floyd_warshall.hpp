@@ -0,0 +1,209 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+#include <concepts>
+#include <type_traits>
+#include "parallel.hpp"
+
+namespace gcl
+{
+    struct FloydWarshallOptions
+    {
+        // タイルの一辺の長さ。0 のときは1タイルがL1キャッシュ（32KiB程度）に収まるように選ぶ
+        std::size_t block = 0;
+        // タイルを並列に処理するスレッド数
+        std::size_t n_threads = 1;
+        // 経路復元用の表を作るか。作る場合はタイル分割を行わない
+        bool restore_path = false;
+    };
+
+    template <typename W>
+    struct FloydWarshallResult
+    {
+        std::size_t n_vertices = 0;
+        bool negative_cycle_exist = false;
+        // `next[i * n_vertices + j]`：`i`から`j`への最短路で`i`の次に通る頂点（`restore_path`が有効な場合のみ）
+        std::vector<std::size_t> next;
+
+        // `from`から`to`への最短路の頂点列を返す。到達不能・経路復元が無効・負閉路がある場合は空列を返す
+        std::vector<std::size_t> restore_path(std::size_t from, std::size_t to) const
+        {
+            const auto none = std::numeric_limits<std::size_t>::max();
+            if (negative_cycle_exist || next.empty() || next[from * n_vertices + to] == none)
+                return {};
+            std::vector<std::size_t> path{from};
+            for (auto v = from; v != to;)
+            {
+                v = next[v * n_vertices + to];
+                path.push_back(v);
+            }
+            return path;
+        }
+    };
+
+    namespace floyd_warshall_detail
+    {
+        // `min(c, cik + b)`。`b`が INF の場合は`c`のまま
+        template <typename W>
+        inline W relax(W c, W b, W cik)
+        {
+            constexpr W INF = std::numeric_limits<W>::max();
+            W cand;
+            if constexpr (std::floating_point<W>)
+            {
+                // 浮動小数点数では加算を先に行っても未定義動作にならず、分岐を消せる
+                const W sum = cik + b;
+                cand = b == INF ? INF : sum;
+            }
+            else
+                cand = b == INF ? INF : cik + b;
+            return cand < c ? cand : c;
+        }
+
+        // min-plus 積の内側のループ：`c[j] = min(c[j], cik + b[j])`
+        // 32 バイト分ずつ固定長で回すことで、-O2 でも（整数型は）自動ベクトル化されやすくしている
+        template <typename W>
+        inline void update_row(W *__restrict c, const W *__restrict b, W cik, std::size_t len)
+        {
+            constexpr std::size_t LANES = 32 / sizeof(W) > 0 ? 32 / sizeof(W) : 1;
+            std::size_t j = 0;
+            for (; j + LANES <= len; j += LANES)
+            {
+                for (std::size_t t = 0; t < LANES; t++)
+                    c[j + t] = relax(c[j + t], b[j + t], cik);
+            }
+            for (; j < len; j++)
+                c[j] = relax(c[j], b[j], cik);
+        }
+
+        // タイル`(ib, jb)`を、`k`が`kb`番目のタイルの範囲にある中継点で更新する
+        template <typename W>
+        void update_tile(W *d, std::size_t n, std::size_t block, std::size_t ib, std::size_t jb, std::size_t kb)
+        {
+            constexpr W INF = std::numeric_limits<W>::max();
+            const auto i_end = std::min(n, (ib + 1) * block);
+            const auto j_first = jb * block, j_end = std::min(n, (jb + 1) * block);
+            const auto k_end = std::min(n, (kb + 1) * block);
+            const auto len = j_end - j_first;
+            for (auto k = kb * block; k < k_end; k++)
+            {
+                const W *row_k = d + k * n + j_first;
+                for (auto i = ib * block; i < i_end; i++)
+                {
+                    const W dik = d[i * n + k];
+                    if (dik == INF)
+                        continue;
+                    W *row_i = d + i * n + j_first;
+                    if (row_i == row_k)
+                    {
+                        // 同じ行を読み書きする場合（ベクトル化しない）
+                        for (std::size_t j = 0; j < len; j++)
+                        {
+                            if (row_k[j] != INF && dik + row_k[j] < row_i[j])
+                                row_i[j] = dik + row_k[j];
+                        }
+                        continue;
+                    }
+                    update_row(row_i, row_k, dik, len);
+                }
+            }
+        }
+    }
+
+    // Floyd-Warshall法による全点対最短経路。`dist`は長さ`n * n`の行優先の行列であり、
+    // `dist[i * n + j]`に辺`i -> j`の重み（無ければ`std::numeric_limits<W>::max()`）を入れて渡す
+    // 計算後は`dist[i * n + j]`が`i`から`j`への最短距離になる。負辺を含んでも良い
+    template <typename W>
+        requires std::is_arithmetic_v<W>
+    FloydWarshallResult<W> floyd_warshall(std::vector<W> &dist, std::size_t n, FloydWarshallOptions options = {})
+    {
+        constexpr W INF = std::numeric_limits<W>::max();
+        constexpr auto NONE = std::numeric_limits<std::size_t>::max();
+        assert(dist.size() >= n * n);
+
+        FloydWarshallResult<W> result;
+        result.n_vertices = n;
+        for (std::size_t i = 0; i < n; i++)
+            dist[i * n + i] = std::min(dist[i * n + i], W{});
+
+        if (options.restore_path)
+        {
+            result.next.assign(n * n, NONE);
+            for (std::size_t i = 0; i < n; i++)
+            {
+                for (std::size_t j = 0; j < n; j++)
+                {
+                    if (dist[i * n + j] != INF)
+                        result.next[i * n + j] = j;
+                }
+            }
+            // 中継点`k`を固定すると`k`行目と`k`列目は変化しないので、各行を並列に更新出来る
+            for (std::size_t k = 0; k < n; k++)
+            {
+                parallel_for_blocks(n, options.n_threads, 64,
+                                    [&](std::size_t first, std::size_t last, std::size_t)
+                                    {
+                                        for (auto i = first; i < last; i++)
+                                        {
+                                            const W dik = dist[i * n + k];
+                                            if (dik == INF || i == k)
+                                                continue;
+                                            for (std::size_t j = 0; j < n; j++)
+                                            {
+                                                const W dkj = dist[k * n + j];
+                                                if (dkj != INF && dik + dkj < dist[i * n + j])
+                                                {
+                                                    dist[i * n + j] = dik + dkj;
+                                                    result.next[i * n + j] = result.next[i * n + k];
+                                                }
+                                            }
+                                        }
+                                    });
+            }
+        }
+        else
+        {
+            auto block = options.block;
+            if (block == 0)
+            {
+                block = static_cast<std::size_t>(std::sqrt(32768.0 / sizeof(W)));
+                block = std::max<std::size_t>(16, block / 8 * 8);
+            }
+            const auto nb = (n + block - 1) / block;
+            W *d = dist.data();
+            for (std::size_t kb = 0; kb < nb; kb++)
+            {
+                // 1. 対角タイル
+                floyd_warshall_detail::update_tile(d, n, block, kb, kb, kb);
+                // 2. 対角タイルと同じ行・列のタイル
+                parallel_for(2 * (nb - 1), options.n_threads,
+                             [&](std::size_t t, std::size_t)
+                             {
+                                 auto other = t / 2;
+                                 other += (other >= kb);
+                                 if (t % 2 == 0)
+                                     floyd_warshall_detail::update_tile(d, n, block, kb, other, kb);
+                                 else
+                                     floyd_warshall_detail::update_tile(d, n, block, other, kb, kb);
+                             });
+                // 3. 残りのタイル（互いに独立）
+                parallel_for((nb - 1) * (nb - 1), options.n_threads,
+                             [&](std::size_t t, std::size_t)
+                             {
+                                 auto ib = t / (nb - 1), jb = t % (nb - 1);
+                                 ib += (ib >= kb);
+                                 jb += (jb >= kb);
+                                 floyd_warshall_detail::update_tile(d, n, block, ib, jb, kb);
+                             });
+            }
+        }
+
+        for (std::size_t i = 0; i < n; i++)
+            result.negative_cycle_exist |= dist[i * n + i] < W{};
+        return result;
+    }
+}
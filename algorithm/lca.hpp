@@ -0,0 +1,150 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <concepts>
+#include <limits>
+#include <span>
+#include <utility>
+#include "parallel.hpp"
+#include "../data-structure/graph.hpp"
+#include "../data-structure/sparse_table.hpp"
+
+namespace gcl
+{
+    // 静的な木の最小共通祖先（LCA）を O(1) で返す
+    // 再帰を使わない DFS で行きがけ順を求め、行きがけ順の`i`番目の頂点の親の訪問時刻を Sparse Table に載せる
+    // `u != v`かつ`tin[u] < tin[v]`のとき、区間`(tin[u], tin[v]]`で親の訪問時刻が最小の頂点の親が LCA になる
+    // `W`は根からの距離の型。`Graph`から構築した場合は辺の本数、`WGraph<W>`から構築した場合は重みの和を距離とする
+    template <typename W = std::size_t>
+    class LCA
+    {
+    public:
+        using weight_type = W;
+
+        // 重みなしの木`tree`（各辺を両方向に持つ）を根`root`で構築する
+        explicit LCA(const Graph &tree, std::size_t root = 0)
+            requires std::integral<W>
+            : LCA(tree, root, [](const Edge &)
+                  { return W{1}; })
+        {
+        }
+
+        // 重み付きの木`tree`（各辺を両方向に持つ）を根`root`で構築する
+        explicit LCA(const WGraph<W> &tree, std::size_t root = 0)
+            : LCA(tree, root, [](const WEdge<W> &e)
+                  { return e.weight; })
+        {
+        }
+
+        // 頂点`u`と`v`の最小共通祖先
+        [[nodiscard]] std::size_t lca(std::size_t u, std::size_t v) const
+        {
+            assert(u < size() && v < size());
+            if (u == v)
+                return u;
+            auto l = tin_[u], r = tin_[v];
+            if (l > r)
+                std::swap(l, r);
+            return order_[table_.prod(l + 1, r + 1)];
+        }
+
+        // 頂点`u`と`v`の間の距離（`Graph`から構築した場合は辺の本数）
+        [[nodiscard]] W distance(std::size_t u, std::size_t v) const
+        {
+            return dist_[u] + dist_[v] - 2 * dist_[lca(u, v)];
+        }
+
+        // `queries[i] = (u, v)`の LCA を並べて返す。`n_threads`本のスレッドで分担する
+        [[nodiscard]] std::vector<std::size_t> lca(std::span<const std::pair<std::size_t, std::size_t>> queries, std::size_t n_threads = 1) const
+        {
+            std::vector<std::size_t> result(queries.size());
+            parallel_for_blocks(queries.size(), n_threads, BATCH_BLOCK,
+                                [&](std::size_t first, std::size_t last, std::size_t)
+                                {
+                                    for (auto i = first; i < last; i++)
+                                        result[i] = lca(queries[i].first, queries[i].second);
+                                });
+            return result;
+        }
+
+        // `queries[i] = (u, v)`の距離を並べて返す。`n_threads`本のスレッドで分担する
+        [[nodiscard]] std::vector<W> distance(std::span<const std::pair<std::size_t, std::size_t>> queries, std::size_t n_threads = 1) const
+        {
+            std::vector<W> result(queries.size());
+            parallel_for_blocks(queries.size(), n_threads, BATCH_BLOCK,
+                                [&](std::size_t first, std::size_t last, std::size_t)
+                                {
+                                    for (auto i = first; i < last; i++)
+                                        result[i] = distance(queries[i].first, queries[i].second);
+                                });
+            return result;
+        }
+
+        // 根から`v`までの辺の本数
+        [[nodiscard]] std::size_t depth(std::size_t v) const { return depth_[v]; }
+
+        // 根から`v`までの距離（`Graph`から構築した場合は`depth(v)`と等しい）
+        [[nodiscard]] const W &dist(std::size_t v) const { return dist_[v]; }
+
+        // `v`の親（根の場合は`v`自身）
+        [[nodiscard]] std::size_t parent(std::size_t v) const { return parent_[v]; }
+
+        // 行きがけ順で`v`が何番目か（`v`の部分木は`[tin(v), tin(v) + subtree_size)`に並ぶ）
+        [[nodiscard]] std::size_t tin(std::size_t v) const { return tin_[v]; }
+
+        std::size_t size() const { return tin_.size(); }
+
+    private:
+        static constexpr std::size_t BATCH_BLOCK = 4096;
+
+        std::vector<std::uint32_t> tin_, order_, parent_, depth_;
+        std::vector<W> dist_;
+        SparseTable<std::uint32_t> table_;
+
+        template <class G, class WeightOf>
+        LCA(const G &tree, std::size_t root, WeightOf weight_of)
+        {
+            const auto n = tree.size();
+            assert(root < n && n <= std::numeric_limits<std::uint32_t>::max());
+            constexpr auto NONE = std::numeric_limits<std::uint32_t>::max();
+            tin_.assign(n, NONE);
+            order_.reserve(n);
+            parent_.assign(n, NONE);
+            depth_.assign(n, 0);
+            dist_.assign(n, W{});
+
+            // 頂点を取り出した時点で子を全て積むと、部分木が行きがけ順で連続した区間に並ぶ
+            std::vector<std::uint32_t> stack{static_cast<std::uint32_t>(root)};
+            parent_[root] = static_cast<std::uint32_t>(root);
+            std::vector<std::uint32_t> parent_tin(n);
+            while (!stack.empty())
+            {
+                const auto v = stack.back();
+                stack.pop_back();
+                tin_[v] = static_cast<std::uint32_t>(order_.size());
+                parent_tin[order_.size()] = tin_[parent_[v]];
+                order_.push_back(v);
+                for (const auto &e : tree[v])
+                {
+                    const auto to = static_cast<std::uint32_t>(e.to);
+                    if (to == parent_[v])
+                        continue;
+                    assert(tin_[to] == NONE);
+                    parent_[to] = v;
+                    depth_[to] = depth_[v] + 1;
+                    dist_[to] = dist_[v] + weight_of(e);
+                    stack.push_back(to);
+                }
+            }
+            assert(order_.size() == n);
+            table_ = SparseTable<std::uint32_t>(std::move(parent_tin));
+        }
+    };
+
+    LCA(const Graph &, std::size_t = 0) -> LCA<std::size_t>;
+
+    template <typename W>
+    LCA(const WGraph<W> &, std::size_t = 0) -> LCA<W>;
+}
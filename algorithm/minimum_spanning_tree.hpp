@@ -1,8 +1,24 @@
+#pragma once
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <type_traits>
+#include <utility>
 #include <ranges>
+#include <cstdint>
+#include <limits>
+#include <atomic>
+#include <span>
+#include <tuple>
+#include <cassert>
+#include "parallel.hpp"
 #include "../data-structure/graph.hpp"
+#include "../data-structure/csr_graph.hpp"
 #include "../data-structure/unionfind.hpp"
+#include "../data-structure/concurrent_unionfind.hpp"
+#include "../data-structure/indexed_dary_heap.hpp"
 #include "../concepts/graph_concepts.hpp"
 
 namespace gcl
@@ -45,46 +61,674 @@ namespace gcl
             }
             return mst;
         }
+
+        // 元グラフの頂点数を渡して、MST（連結でない場合はMSF）を無向の`CSRGraph`として返す
+        template <std::unsigned_integral Index = std::uint32_t>
+        auto build_mst_csr(std::size_t n_vertices) const -> CSRGraph<W, Index>
+        {
+            return CSRGraph<W, Index>(n_vertices, edges, true);
+        }
+    };
+
+    // 辺番号で表した最小全域木（森）。`edge_ids`は入力の辺番号を採用した順（重みの昇順）に並べたもの
+    template <class W>
+    struct KruskalIndexResult
+    {
+        W total_weight{};
+        std::vector<std::size_t> edge_ids;
+        bool is_connected = false;
     };
 
+    namespace mst_detail
+    {
+        // 辺を (重み, from, to) の辞書順で比較する。全ての Kruskal 系の関数はこの順序で辺を採用する
+        struct EdgeLess
+        {
+            template <class W>
+            bool operator()(const UWEdge<W> &a, const UWEdge<W> &b) const
+            {
+                if (a.weight != b.weight)
+                    return a.weight < b.weight;
+                if (a.from != b.from)
+                    return a.from < b.from;
+                return a.to < b.to;
+            }
+        };
+
+        // 頂点数に応じた`CompactUnionFind`を作り`f(uf)`を呼ぶ（収まる限り 32bit 版を使う）
+        template <class F>
+        void with_compact_unionfind(std::size_t n_vertices, F &&f)
+        {
+            if (n_vertices <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+            {
+                CompactUnionFind<std::int32_t> uf(n_vertices);
+                f(uf);
+            }
+            else
+            {
+                CompactUnionFind<std::int64_t> uf(n_vertices);
+                f(uf);
+            }
+        }
+
+        // 辺`edge`を採用できれば`result`に追加する。全域木が完成したら`true`を返す
+        template <class W, class UF>
+        bool take_edge(std::size_t n_vertices, UF &uf, UWEdge<W> &edge, KruskalResult<W> &result)
+        {
+            if (!uf.unite(edge.from, edge.to))
+                return false;
+            result.total_weight += edge.weight;
+            result.edges.push_back(std::move(edge));
+            return result.edges.size() + 1 == n_vertices;
+        }
+
+        template <class W>
+        void finish(std::size_t n_vertices, KruskalResult<W> &result)
+        {
+            result.is_connected = (n_vertices == 0) ? true : (result.edges.size() == n_vertices - 1);
+        }
+
+        // 整数の重みを、大小関係を保つ符号なし 64bit 整数に写す（符号付きなら最上位ビットを反転する）
+        template <std::integral W>
+        std::uint64_t radix_key(W w)
+        {
+            using U = std::make_unsigned_t<W>;
+            auto u = static_cast<U>(w);
+            if constexpr (std::signed_integral<W>)
+                u ^= U{1} << (8 * sizeof(W) - 1);
+            return static_cast<std::uint64_t>(u);
+        }
+
+        // `radix_key`の逆変換
+        template <std::integral W>
+        W radix_weight(std::uint64_t key)
+        {
+            using U = std::make_unsigned_t<W>;
+            auto u = static_cast<U>(key);
+            if constexpr (std::signed_integral<W>)
+                u ^= U{1} << (8 * sizeof(W) - 1);
+            return static_cast<W>(u);
+        }
+
+        // `key(x)`について 11bit ずつの LSD 基数ソートを行う（安定）。`buffer`は作業領域
+        // 全ての要素で値が等しい桁は並べ替えが不要なので飛ばす
+        template <class T, class Key>
+        void radix_sort_by(std::vector<T> &values, std::vector<T> &buffer, Key key)
+        {
+            constexpr std::size_t BITS = 11, BUCKETS = std::size_t{1} << BITS, DIGITS = (64 + BITS - 1) / BITS;
+            const auto n = values.size();
+            std::vector<std::array<std::size_t, BUCKETS>> count(DIGITS);
+            for (auto &c : count)
+                c.fill(0);
+            for (const auto &x : values)
+            {
+                const auto k = key(x);
+                for (std::size_t d = 0; d < DIGITS; d++)
+                    count[d][(k >> (BITS * d)) & (BUCKETS - 1)]++;
+            }
+            for (std::size_t d = 0; d < DIGITS; d++)
+            {
+                if (std::ranges::find(count[d], n) != count[d].end())
+                    continue;
+                std::size_t sum = 0;
+                for (auto &c : count[d])
+                    sum += std::exchange(c, sum);
+                buffer.resize(n);
+                for (auto &x : values)
+                    buffer[count[d][(key(x) >> (BITS * d)) & (BUCKETS - 1)]++] = std::move(x);
+                values.swap(buffer);
+            }
+        }
+
+        // 基数ソート用に詰めた辺。`endpoints`は`from`と`to`を連結したもの、`weight`は`radix_key`
+        struct RadixEdge
+        {
+            std::uint64_t endpoints, weight;
+        };
+
+        // Filter-Kruskal の再帰部分。`[first, last)`の辺を (重み, from, to) の順に処理する
+        // 全域木が完成したら`true`を返す
+        template <class W, class UF>
+        bool filter_kruskal_rec(std::size_t n_vertices, UF &uf, KruskalResult<W> &result,
+                                typename std::vector<UWEdge<W>>::iterator first, typename std::vector<UWEdge<W>>::iterator last)
+        {
+            constexpr std::ptrdiff_t THRESHOLD = 1024;
+            const EdgeLess less;
+            if (last - first <= THRESHOLD)
+            {
+                std::sort(first, last, less);
+                for (auto it = first; it != last; ++it)
+                {
+                    if (take_edge(n_vertices, uf, *it, result))
+                        return true;
+                }
+                return false;
+            }
+
+            // 3点の中央値を軸にして「軸未満」「軸と等しい」「軸より大きい」に分ける
+            auto a = *first, b = *(first + (last - first) / 2), c = *(last - 1);
+            if (less(b, a))
+                std::swap(a, b);
+            if (less(c, b))
+                std::swap(b, c);
+            if (less(b, a))
+                std::swap(a, b);
+            const auto pivot = b;
+            auto mid1 = std::partition(first, last, [&](const auto &e)
+                                       { return less(e, pivot); });
+            auto mid2 = std::partition(mid1, last, [&](const auto &e)
+                                       { return !less(pivot, e); });
+
+            if (filter_kruskal_rec(n_vertices, uf, result, first, mid1))
+                return true;
+            for (auto it = mid1; it != mid2; ++it)
+            {
+                if (take_edge(n_vertices, uf, *it, result))
+                    return true;
+            }
+            // 既に同じ連結成分に属する辺は、ソートする前に取り除く
+            auto kept = std::remove_if(mid2, last, [&](const auto &e)
+                                       { return uf.same(e.from, e.to); });
+            return filter_kruskal_rec(n_vertices, uf, result, mid2, kept);
+        }
+    }
+
     // Kruskal法によって最小全域木を返す
     template <class W>
     auto kruskal(std::size_t n_vertices, std::vector<UWEdge<W>> edges)
         -> KruskalResult<W>
     {
         KruskalResult<W> result;
-        std::sort(edges.begin(), edges.end(),
-                  [](const auto &a, const auto &b)
-                  {
-                      if (a.weight != b.weight)
-                          return a.weight < b.weight;
-                      if (a.from != b.from)
-                          return a.from < b.from;
-                      return a.to < b.to;
-                  });
+        std::sort(edges.begin(), edges.end(), mst_detail::EdgeLess{});
+        mst_detail::with_compact_unionfind(n_vertices, [&](auto &uf)
+                                           {
+                                               for (auto &edge : edges)
+                                               {
+                                                   if (mst_detail::take_edge(n_vertices, uf, edge, result))
+                                                       break;
+                                               } });
+        mst_detail::finish(n_vertices, result);
+        return result;
+    }
 
-        UnionFind uf(n_vertices);
-        for (auto &edge : edges)
+    // Filter-Kruskal法によって最小全域木を返す。結果は`kruskal`と完全に一致する
+    // 軸で辺を分割し、軽い側を先に処理してから、重い側のうち既に連結な頂点を結ぶ辺を取り除いてソートする
+    template <class W>
+    auto filter_kruskal(std::size_t n_vertices, std::vector<UWEdge<W>> edges)
+        -> KruskalResult<W>
+    {
+        KruskalResult<W> result;
+        mst_detail::with_compact_unionfind(n_vertices, [&](auto &uf)
+                                           { mst_detail::filter_kruskal_rec(n_vertices, uf, result, edges.begin(), edges.end()); });
+        mst_detail::finish(n_vertices, result);
+        return result;
+    }
+
+    // 整数の重みの辺を LSD 基数ソートしてから Kruskal 法を行う。結果は`kruskal`と完全に一致する
+    // (from, to) を連結したキー、重みの順に安定に並べ替えることで (重み, from, to) の順序を得る
+    // 頂点番号2つが 64bit に収まる場合は、辺を 16 バイトに詰めてから並べ替える
+    template <std::integral W>
+        requires(sizeof(W) <= 8)
+    auto radix_kruskal(std::size_t n_vertices, std::vector<UWEdge<W>> edges)
+        -> KruskalResult<W>
+    {
+        KruskalResult<W> result;
+        const auto bits = static_cast<std::size_t>(std::bit_width(n_vertices));
+        if (2 * bits <= 64)
         {
-            if (uf.same(edge.from, edge.to))
-                continue;
-            uf.unite(edge.from, edge.to);
+            std::vector<mst_detail::RadixEdge> packed(edges.size()), buffer;
+            for (std::size_t i = 0; i < edges.size(); i++)
+                packed[i] = {static_cast<std::uint64_t>(edges[i].from) << bits | edges[i].to, mst_detail::radix_key(edges[i].weight)};
+            edges = {};
+            mst_detail::radix_sort_by(packed, buffer, [](const auto &e)
+                                      { return e.endpoints; });
+            mst_detail::radix_sort_by(packed, buffer, [](const auto &e)
+                                      { return e.weight; });
+            buffer = {};
+            const auto mask = (std::uint64_t{1} << bits) - 1;
+            mst_detail::with_compact_unionfind(n_vertices, [&](auto &uf)
+                                               {
+                                                   for (const auto &p : packed)
+                                                   {
+                                                       UWEdge<W> edge(static_cast<std::size_t>(p.endpoints >> bits), static_cast<std::size_t>(p.endpoints & mask),
+                                                                      mst_detail::radix_weight<W>(p.weight));
+                                                       if (mst_detail::take_edge(n_vertices, uf, edge, result))
+                                                           break;
+                                                   } });
+        }
+        else
+        {
+            std::vector<UWEdge<W>> buffer;
+            mst_detail::radix_sort_by(edges, buffer, [](const auto &e)
+                                      { return static_cast<std::uint64_t>(e.to); });
+            mst_detail::radix_sort_by(edges, buffer, [](const auto &e)
+                                      { return static_cast<std::uint64_t>(e.from); });
+            mst_detail::radix_sort_by(edges, buffer, [](const auto &e)
+                                      { return mst_detail::radix_key(e.weight); });
+            buffer = {};
+            mst_detail::with_compact_unionfind(n_vertices, [&](auto &uf)
+                                               {
+                                                   for (auto &edge : edges)
+                                                   {
+                                                       if (mst_detail::take_edge(n_vertices, uf, edge, result))
+                                                           break;
+                                                   } });
+        }
+        mst_detail::finish(n_vertices, result);
+        return result;
+    }
 
-            result.total_weight += edge.weight;
-            result.edges.push_back(std::move(edge));
-            if (result.edges.size() + 1 == n_vertices)
-                break;
+    namespace mst_detail
+    {
+        template <std::signed_integral Index, class W>
+        void boruvka_impl(std::size_t n_vertices, std::vector<UWEdge<W>> &edges, std::size_t n_threads, KruskalResult<W> &result)
+        {
+            constexpr std::size_t BLOCK = 4096;
+            constexpr auto NONE = std::numeric_limits<std::size_t>::max();
+            const EdgeLess less;
+            // 辺番号で同点を解消した狭義全順序。各成分の最小辺はこの順序で一意に決まり、閉路を作らない
+            auto edge_less = [&](std::size_t i, std::size_t j)
+            {
+                if (less(edges[i], edges[j]))
+                    return true;
+                if (less(edges[j], edges[i]))
+                    return false;
+                return i < j;
+            };
+
+            ConcurrentUnionFind<Index> uf(n_vertices);
+            std::vector<std::atomic<std::size_t>> best(n_vertices);
+            for (auto &b : best)
+                b.store(NONE, std::memory_order_relaxed);
+            std::vector<std::vector<std::size_t>> taken(std::max<std::size_t>(n_threads, 1));
+
+            // まだ異なる成分を結んでいる可能性のある辺の番号と、前の周で内部の辺と分かったかどうか
+            std::vector<std::size_t> alive(edges.size()), next_alive;
+            for (std::size_t i = 0; i < edges.size(); i++)
+                alive[i] = i;
+            std::vector<char> internal;
+
+            while (!alive.empty())
+            {
+                const auto n_blocks = (alive.size() + BLOCK - 1) / BLOCK;
+                internal.assign(alive.size(), 0);
+
+                // 1. 各成分について、外へ出る最小の辺を CAS で求める
+                parallel_for(n_blocks, n_threads,
+                             [&](std::size_t b, std::size_t)
+                             {
+                                 const auto last = std::min(alive.size(), (b + 1) * BLOCK);
+                                 for (auto k = b * BLOCK; k < last; k++)
+                                 {
+                                     const auto i = alive[k];
+                                     const auto ru = uf.find(edges[i].from), rv = uf.find(edges[i].to);
+                                     if (ru == rv)
+                                     {
+                                         internal[k] = 1;
+                                         continue;
+                                     }
+                                     for (auto r : {ru, rv})
+                                     {
+                                         auto cur = best[r].load(std::memory_order_relaxed);
+                                         while ((cur == NONE || edge_less(i, cur)) &&
+                                                !best[r].compare_exchange_weak(cur, i, std::memory_order_relaxed))
+                                         {
+                                         }
+                                     }
+                                 }
+                             });
+
+                // 2. 選ばれた辺で成分を縮約する（両側の成分から選ばれた辺は一方でのみ結合に成功する）
+                std::atomic<bool> merged{false};
+                parallel_for_blocks(n_vertices, n_threads, BLOCK,
+                                    [&](std::size_t first, std::size_t last, std::size_t thread_id)
+                                    {
+                                        for (auto v = first; v < last; v++)
+                                        {
+                                            if (best[v].load(std::memory_order_relaxed) == NONE)
+                                                continue;
+                                            const auto i = best[v].exchange(NONE, std::memory_order_relaxed);
+                                            if (uf.unite(edges[i].from, edges[i].to))
+                                            {
+                                                taken[thread_id].push_back(i);
+                                                merged.store(true, std::memory_order_relaxed);
+                                            }
+                                        }
+                                    });
+                if (!merged.load())
+                    break;
+
+                // 3. 手順1で内部の辺と分かった辺を取り除く（ブロックごとに数えてから詰める）
+                //    この周の縮約で内部の辺になったものは次の周で取り除かれる
+                std::vector<std::size_t> offset(n_blocks + 1, 0);
+                parallel_for(n_blocks, n_threads,
+                             [&](std::size_t b, std::size_t)
+                             {
+                                 const auto last = std::min(alive.size(), (b + 1) * BLOCK);
+                                 for (auto k = b * BLOCK; k < last; k++)
+                                     offset[b + 1] += !internal[k];
+                             });
+                for (std::size_t b = 0; b < n_blocks; b++)
+                    offset[b + 1] += offset[b];
+                next_alive.resize(offset.back());
+                parallel_for(n_blocks, n_threads,
+                             [&](std::size_t b, std::size_t)
+                             {
+                                 const auto last = std::min(alive.size(), (b + 1) * BLOCK);
+                                 auto pos = offset[b];
+                                 for (auto k = b * BLOCK; k < last; k++)
+                                 {
+                                     if (!internal[k])
+                                         next_alive[pos++] = alive[k];
+                                 }
+                             });
+                alive.swap(next_alive);
+            }
+
+            // `kruskal`と同じ順序に並べ、同じ順序で重みを足す
+            std::vector<std::size_t> ids;
+            for (const auto &t : taken)
+                ids.insert(ids.end(), t.begin(), t.end());
+            std::sort(ids.begin(), ids.end(), edge_less);
+            result.edges.reserve(ids.size());
+            for (auto i : ids)
+            {
+                result.total_weight += edges[i].weight;
+                result.edges.push_back(std::move(edges[i]));
+            }
+        }
+    }
+
+    // Borůvka法によって最小全域木を`n_threads`本のスレッドで求める。結果は`kruskal`と完全に一致する
+    // 各成分から出る最小の辺を並列に求め、`ConcurrentUnionFind`で縮約することを繰り返す（O(log N) 回）
+    template <class W>
+    auto boruvka(std::size_t n_vertices, std::vector<UWEdge<W>> edges, std::size_t n_threads = default_thread_count())
+        -> KruskalResult<W>
+    {
+        KruskalResult<W> result;
+        if (n_vertices <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+            mst_detail::boruvka_impl<std::int32_t>(n_vertices, edges, n_threads, result);
+        else
+            mst_detail::boruvka_impl<std::int64_t>(n_vertices, edges, n_threads, result);
+        mst_detail::finish(n_vertices, result);
+        return result;
+    }
+
+    namespace mst_detail
+    {
+        // Prim 法で得た辺を`(min, max, w)`の形にして`kruskal`と同じ順序に並べ、その順序で重みを足す
+        template <class W>
+        void finish_prim(std::size_t n_vertices, std::vector<UWEdge<W>> &edges, KruskalResult<W> &result)
+        {
+            for (auto &e : edges)
+            {
+                if (e.to < e.from)
+                    std::swap(e.from, e.to);
+            }
+            std::sort(edges.begin(), edges.end(), EdgeLess{});
+            for (const auto &e : edges)
+                result.total_weight += e.weight;
+            result.edges = std::move(edges);
+            finish(n_vertices, result);
+        }
+    }
+
+    // 配列を用いた O(N^2) の Prim 法によって、完全グラフの最小全域木を返す
+    // `weight(u, v)`は頂点`u, v`間の辺の重みを返す関数であり、辺集合を保持しないのでメモリは O(N) で済む
+    // `weight(u, v)`が`std::numeric_limits<W>::max()`を返す場合は辺が無いものとして扱い、最小全域森を返す
+    template <class F>
+        requires std::invocable<F &, std::size_t, std::size_t>
+    auto prim_dense(std::size_t n_vertices, F &&weight)
+        -> KruskalResult<std::remove_cvref_t<std::invoke_result_t<F &, std::size_t, std::size_t>>>
+    {
+        using W = std::remove_cvref_t<std::invoke_result_t<F &, std::size_t, std::size_t>>;
+        constexpr W INF = std::numeric_limits<W>::max();
+        constexpr auto NONE = std::numeric_limits<std::size_t>::max();
+
+        KruskalResult<W> result;
+        std::vector<UWEdge<W>> edges;
+        // 未使用の頂点を`rest[0..n_rest)`に詰めて持ち、走査を未使用の頂点だけに限る
+        std::vector<std::size_t> rest(n_vertices), parent(n_vertices, NONE);
+        std::vector<W> dist(n_vertices, INF);
+        for (std::size_t v = 0; v < n_vertices; v++)
+            rest[v] = v;
+        auto n_rest = n_vertices;
+        while (n_rest > 0)
+        {
+            // 未使用の頂点のうち`dist`が最小のもの（同点なら番号が最小のもの）を選ぶ
+            std::size_t best = 0;
+            for (std::size_t k = 1; k < n_rest; k++)
+            {
+                const auto v = rest[k], b = rest[best];
+                if (dist[v] < dist[b] || (!(dist[b] < dist[v]) && v < b))
+                    best = k;
+            }
+            const auto u = rest[best];
+            rest[best] = rest[--n_rest];
+            if (parent[u] != NONE)
+                edges.emplace_back(parent[u], u, dist[u]);
+
+            for (std::size_t k = 0; k < n_rest; k++)
+            {
+                const auto v = rest[k];
+                const W w = weight(u, v);
+                if (w != INF && (parent[v] == NONE || w < dist[v]))
+                {
+                    dist[v] = w;
+                    parent[v] = u;
+                }
+            }
         }
+        mst_detail::finish_prim(n_vertices, edges, result);
+        return result;
+    }
+
+    // `IndexedDaryHeap`を用いた Prim 法によって最小全域木を返す。計算量は O(|E| log N)
+    // `graph`は無向グラフであり、 `u->v` と `v->u` の両方が含まれることを前提とする。非連結の場合は最小全域森を返す
+    template <WeightedGraph G>
+    auto prim(const G &graph)
+        -> KruskalResult<weight_t<G>>
+    {
+        using W = weight_t<G>;
+        constexpr auto NONE = std::numeric_limits<std::size_t>::max();
+        const std::size_t n = std::ranges::size(graph);
 
-        result.is_connected = (n_vertices == 0) ? true : (result.edges.size() == n_vertices - 1);
+        KruskalResult<W> result;
+        std::vector<UWEdge<W>> edges;
+        std::vector<std::size_t> parent(n, NONE);
+        std::vector<char> used(n, 0);
+        IndexedDaryHeap<W> heap(n);
+        for (std::size_t root = 0; root < n; root++)
+        {
+            if (used[root])
+                continue;
+            heap.push(root, W{});
+            while (!heap.empty())
+            {
+                auto [d, u] = heap.pop();
+                used[u] = 1;
+                if (parent[u] != NONE)
+                    edges.emplace_back(parent[u], u, std::move(d));
+                for (const auto &e : graph[u])
+                {
+                    const auto v = static_cast<std::size_t>(e.to);
+                    if (used[v])
+                        continue;
+                    if (heap.push_or_decrease(v, e.weight))
+                        parent[v] = u;
+                }
+            }
+        }
+        mst_detail::finish_prim(n, edges, result);
         return result;
     }
 
-    // Kruskal法によって最小全域木を返す。`graph`は無向グラフであり、 `u->v` と `v->u` の両方が含まれることを前提とする。
+    namespace mst_detail
+    {
+        // CSR の辺番号`id`の始点を求める
+        template <class W, class Index>
+        std::size_t csr_source(const CSRGraph<W, Index> &graph, std::size_t id)
+        {
+            const auto &offsets = graph.offsets();
+            return static_cast<std::size_t>(std::ranges::upper_bound(offsets, id) - offsets.begin()) - 1;
+        }
+
+        // 並べ替え済みの辺番号の列`ids`に対して Kruskal 法を行う。`edge(id)`は`{from, to, weight}`を返す
+        template <class W, class Range, class Edge>
+        KruskalIndexResult<W> kruskal_on_order(std::size_t n_vertices, const Range &ids, Edge edge)
+        {
+            KruskalIndexResult<W> result;
+            with_compact_unionfind(n_vertices, [&](auto &uf)
+                                   {
+                                       for (auto id : ids)
+                                       {
+                                           const auto [from, to, weight] = edge(static_cast<std::size_t>(id));
+                                           if (!uf.unite(from, to))
+                                               continue;
+                                           result.total_weight += weight;
+                                           result.edge_ids.push_back(static_cast<std::size_t>(id));
+                                           if (result.edge_ids.size() + 1 == n_vertices)
+                                               break;
+                                       } });
+            result.is_connected = (n_vertices == 0) ? true : (result.edge_ids.size() == n_vertices - 1);
+            return result;
+        }
+    }
+
+    // 辺集合`edges`を呼び出し側の配列のまま (重み, from, to) の順に並べ替えて Kruskal 法を行う（辺をコピーしない）
+    // 返り値の`edge_ids`は並べ替えた後の`edges`の添字であり、採用される辺は`kruskal`と一致する
     template <class W>
-    auto kruskal(const WGraph<W> &graph)
-        -> KruskalResult<W>
+    auto kruskal_inplace(std::size_t n_vertices, std::vector<UWEdge<W>> &edges)
+        -> KruskalIndexResult<W>
+    {
+        std::sort(edges.begin(), edges.end(), mst_detail::EdgeLess{});
+        return mst_detail::kruskal_on_order<W>(n_vertices, std::views::iota(std::size_t{0}, edges.size()),
+                                               [&](std::size_t id)
+                                               { return std::tuple<std::size_t, std::size_t, const W &>{edges[id].from, edges[id].to, edges[id].weight}; });
+    }
+
+    // 無向の`CSRGraph`（`u->v`と`v->u`の両方を持つ）に対して、辺番号だけを`order`に並べ替えて Kruskal 法を行う
+    // `order`は呼び出し側が用意する作業領域で、`u < v`である辺の本数（`graph.num_edges() / 2`）以上の長さが必要
+    // 辺は (重み, 辺番号) の順に採用するため、重みが等しい辺があると`kruskal`の (重み, from, to) 順とは
+    // 採用される辺の集合が異なることがある（`total_weight`は一致する）。返り値の`edge_ids`は`graph.targets()`の添字
+    // 重みが 32bit 以下の整数で`order`の要素が 64bit の場合は、(重み, 辺番号) を1つの整数に詰めて並べ替える
+    template <class W, std::unsigned_integral Index, std::unsigned_integral Id>
+    auto kruskal_inplace(const CSRGraph<W, Index> &graph, std::span<Id> order)
+        -> KruskalIndexResult<W>
+    {
+        const auto n = graph.size();
+        const auto &offsets = graph.offsets();
+        const auto &targets = graph.targets();
+        const auto &weights = graph.weights();
+        assert(graph.num_edges() <= static_cast<std::size_t>(std::numeric_limits<Id>::max()));
+
+        // 辺番号から始点を二分探索せずに引けるよう、列挙のついでに始点を記録しておく
+        std::vector<Index> sources(graph.num_edges());
+        std::size_t m = 0;
+        for (std::size_t u = 0; u < n; u++)
+        {
+            for (auto i = offsets[u]; i < offsets[u + 1]; i++)
+            {
+                if (u < static_cast<std::size_t>(targets[i]))
+                {
+                    assert(m < order.size());
+                    order[m++] = static_cast<Id>(i);
+                    sources[i] = static_cast<Index>(u);
+                }
+            }
+        }
+        const auto ids = order.first(m);
+        auto edge = [&](std::size_t id)
+        { return std::tuple<std::size_t, std::size_t, const W &>{static_cast<std::size_t>(sources[id]), static_cast<std::size_t>(targets[id]), weights[id]}; };
+
+        if constexpr (std::integral<W> && sizeof(W) <= 4 && sizeof(Id) == 8)
+        {
+            if (graph.num_edges() <= std::numeric_limits<std::uint32_t>::max())
+            {
+                // 上位 32bit に重み、下位 32bit に辺番号を詰めると、整数としての大小が (重み, 辺番号) の順になる
+                for (auto &key : ids)
+                    key = static_cast<Id>(mst_detail::radix_key(weights[key]) << 32 | key);
+                std::sort(ids.begin(), ids.end());
+                for (auto &key : ids)
+                    key &= 0xffffffffu;
+                return mst_detail::kruskal_on_order<W>(n, ids, edge);
+            }
+        }
+        std::sort(ids.begin(), ids.end(), [&](Id a, Id b)
+                  {
+                      if (weights[a] != weights[b])
+                          return weights[a] < weights[b];
+                      return a < b; });
+        return mst_detail::kruskal_on_order<W>(n, ids, edge);
+    }
+
+    // `kruskal_inplace(graph, order)`の作業領域を内部で確保する版
+    template <class W, std::unsigned_integral Index>
+    auto kruskal_inplace(const CSRGraph<W, Index> &graph)
+        -> KruskalIndexResult<W>
+    {
+        if (graph.num_edges() <= std::numeric_limits<std::uint32_t>::max() && !(std::integral<W> && sizeof(W) <= 4))
+        {
+            std::vector<std::uint32_t> order(graph.num_edges() / 2 + 1);
+            return kruskal_inplace(graph, std::span<std::uint32_t>(order));
+        }
+        std::vector<std::uint64_t> order(graph.num_edges() / 2 + 1);
+        return kruskal_inplace(graph, std::span<std::uint64_t>(order));
+    }
+
+    // `kruskal_inplace`の結果から、最小全域木（森）を無向の`CSRGraph`として構築する
+    template <class W, std::unsigned_integral Index>
+    auto build_mst_csr(const CSRGraph<W, Index> &graph, const KruskalIndexResult<W> &result)
+        -> CSRGraph<W, Index>
+    {
+        std::vector<UWEdge<W>> edges;
+        edges.reserve(result.edge_ids.size());
+        for (auto id : result.edge_ids)
+            edges.emplace_back(mst_detail::csr_source(graph, id), static_cast<std::size_t>(graph.targets()[id]), graph.weights()[id]);
+        return CSRGraph<W, Index>(graph.size(), edges, true);
+    }
+
+    template <class W, std::unsigned_integral Index = std::uint32_t>
+    auto build_mst_csr(std::size_t n_vertices, const std::vector<UWEdge<W>> &edges, const KruskalIndexResult<W> &result)
+        -> CSRGraph<W, Index>
+    {
+        std::vector<UWEdge<W>> tree;
+        tree.reserve(result.edge_ids.size());
+        for (auto id : result.edge_ids)
+            tree.push_back(edges[id]);
+        return CSRGraph<W, Index>(n_vertices, tree, true);
+    }
+
+    // Kruskal法によって最小全域木を返す。`graph`は無向グラフであり、 `u->v` と `v->u` の両方が含まれることを前提とする。
+    template <WeightedGraph G>
+    auto kruskal(const G &graph)
+        -> KruskalResult<weight_t<G>>
+    {
+        return kruskal(std::ranges::size(graph), edges_from_undirected_adj(graph));
+    }
+
+    // Filter-Kruskal法によって最小全域木を返す。`graph`は無向グラフであり、 `u->v` と `v->u` の両方が含まれることを前提とする。
+    template <WeightedGraph G>
+    auto filter_kruskal(const G &graph)
+        -> KruskalResult<weight_t<G>>
+    {
+        return filter_kruskal(std::ranges::size(graph), edges_from_undirected_adj(graph));
+    }
+
+    // 基数ソートを用いたKruskal法によって最小全域木を返す。`graph`は無向グラフであり、 `u->v` と `v->u` の両方が含まれることを前提とする。
+    template <WeightedGraph G>
+        requires std::integral<weight_t<G>> && (sizeof(weight_t<G>) <= 8)
+    auto radix_kruskal(const G &graph)
+        -> KruskalResult<weight_t<G>>
+    {
+        return radix_kruskal(std::ranges::size(graph), edges_from_undirected_adj(graph));
+    }
+
+    // Borůvka法によって最小全域木を`n_threads`本のスレッドで求める。`graph`は無向グラフであり、 `u->v` と `v->u` の両方が含まれることを前提とする。
+    template <WeightedGraph G>
+    auto boruvka(const G &graph, std::size_t n_threads = default_thread_count())
+        -> KruskalResult<weight_t<G>>
     {
-        return kruskal(graph.size(), edges_from_undirected_adj(graph));
+        return boruvka(std::ranges::size(graph), edges_from_undirected_adj(graph), n_threads);
     }
 }
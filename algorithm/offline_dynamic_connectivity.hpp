@@ -0,0 +1,130 @@
+#pragma once
+#include <map>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include "../data-structure/unionfind.hpp"
+
+namespace gcl
+{
+    // 辺の追加・削除と連結性の問い合わせの列を先読みして処理する（オフライン動的連結性）
+    // 各辺が存在する問い合わせの区間を時間軸上のセグメント木に載せ、
+    // 木を辿りながら`RollbackUnionFind`に辺を追加・取り消しする
+    class OfflineDynamicConnectivity
+    {
+    public:
+        /*
+            @brief 頂点数 n の空グラフから始める
+        */
+        explicit OfflineDynamicConnectivity(std::size_t n_vertices) : n_vertices_(n_vertices) {}
+
+        // 無向辺`u - v`を追加する。同じ辺を複数回追加しても良い（多重辺として扱う）
+        void add_edge(std::size_t u, std::size_t v)
+        {
+            assert(u < n_vertices_ && v < n_vertices_);
+            open_[normalize(u, v)].push_back(queries_.size());
+        }
+
+        // 無向辺`u - v`を1本削除する（その辺が存在する必要がある）
+        void remove_edge(std::size_t u, std::size_t v)
+        {
+            const auto edge = normalize(u, v);
+            auto it = open_.find(edge);
+            assert(it != open_.end() && !it->second.empty());
+            const auto first = it->second.back();
+            it->second.pop_back();
+            if (it->second.empty())
+                open_.erase(it);
+            if (first < queries_.size())
+                intervals_.push_back({first, queries_.size(), edge.first, edge.second});
+        }
+
+        // 現時点で`u`と`v`が連結かを問い合わせる。返り値は`solve()`の結果の添字
+        std::size_t same(std::size_t u, std::size_t v)
+        {
+            assert(u < n_vertices_ && v < n_vertices_);
+            queries_.emplace_back(u, v);
+            return queries_.size() - 1;
+        }
+
+        // 全ての問い合わせに答える。`i`番目の要素が`i`番目の`same`の答え
+        // 計算量は O((N + Q) log Q log N)（Q は操作の回数）
+        [[nodiscard]] std::vector<bool> solve() const
+        {
+            const auto q = queries_.size();
+            std::vector<bool> answers(q);
+            if (q == 0)
+                return answers;
+
+            // 区間`[first, last)`を完全に覆うノードに辺を載せる
+            std::size_t size = 1;
+            while (size < q)
+                size *= 2;
+            std::vector<std::vector<std::pair<std::size_t, std::size_t>>> node_edges(2 * size);
+            auto add_interval = [&](std::size_t first, std::size_t last, std::size_t u, std::size_t v)
+            {
+                for (first += size, last += size; first < last; first /= 2, last /= 2)
+                {
+                    if (first & 1)
+                        node_edges[first++].emplace_back(u, v);
+                    if (last & 1)
+                        node_edges[--last].emplace_back(u, v);
+                }
+            };
+            for (const auto &iv : intervals_)
+                add_interval(iv.first, iv.last, iv.u, iv.v);
+            for (const auto &[edge, starts] : open_)
+            {
+                for (auto first : starts)
+                {
+                    if (first < q)
+                        add_interval(first, q, edge.first, edge.second);
+                }
+            }
+
+            // セグメント木を深さ優先に辿る（深さは O(log Q) なので再帰で良い）
+            RollbackUnionFind uf(n_vertices_);
+            // `node`は問い合わせ`[lo, lo + width)`を担当する
+            auto dfs = [&](auto &&self, std::size_t node, std::size_t lo, std::size_t width) -> void
+            {
+                if (lo >= q)
+                    return;
+                const auto state = uf.snapshot();
+                for (const auto &[u, v] : node_edges[node])
+                    uf.unite(u, v);
+                if (node >= size)
+                {
+                    const auto &[u, v] = queries_[node - size];
+                    answers[node - size] = uf.same(u, v);
+                }
+                else
+                {
+                    self(self, 2 * node, lo, width / 2);
+                    self(self, 2 * node + 1, lo + width / 2, width / 2);
+                }
+                uf.rollback(state);
+            };
+            dfs(dfs, 1, 0, size);
+            return answers;
+        }
+
+    private:
+        struct Interval
+        {
+            std::size_t first, last, u, v;
+        };
+
+        std::size_t n_vertices_;
+        std::vector<std::pair<std::size_t, std::size_t>> queries_;
+        // 削除済みの辺が存在した問い合わせの区間
+        std::vector<Interval> intervals_;
+        // 現在存在する辺と、それぞれが追加された時点の問い合わせ数
+        std::map<std::pair<std::size_t, std::size_t>, std::vector<std::size_t>> open_;
+
+        static std::pair<std::size_t, std::size_t> normalize(std::size_t u, std::size_t v)
+        {
+            return u < v ? std::pair{u, v} : std::pair{v, u};
+        }
+    };
+}
@@ -0,0 +1,171 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstddef>
+#include <algorithm>
+#include <concepts>
+#include <mutex>
+#include <condition_variable>
+
+namespace gcl
+{
+    // 利用可能なハードウェアスレッド数（取得できなければ1）を返す
+    inline std::size_t default_thread_count()
+    {
+        return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    // タスク`0..n_tasks-1`を`n_threads`本のスレッドで処理し、各タスクについて`f(task, thread_id)`を呼ぶ
+    // 各スレッドは共有カウンタから次のタスクを1つずつ取るため、タスクごとの処理時間に偏りがあっても負荷が均される
+    // `thread_id`は`0..n_threads-1`であり、スレッドごとの作業領域の添字として使える
+    template <class F>
+        requires std::invocable<F &, std::size_t, std::size_t>
+    void parallel_for(std::size_t n_tasks, std::size_t n_threads, F &&f)
+    {
+        n_threads = std::clamp<std::size_t>(n_threads, 1, std::max<std::size_t>(n_tasks, 1));
+        if (n_threads == 1)
+        {
+            for (std::size_t i = 0; i < n_tasks; i++)
+                f(i, std::size_t{0});
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        auto worker = [&](std::size_t thread_id)
+        {
+            for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < n_tasks;
+                 i = next.fetch_add(1, std::memory_order_relaxed))
+                f(i, thread_id);
+        };
+
+        std::vector<std::jthread> threads;
+        threads.reserve(n_threads - 1);
+        for (std::size_t t = 1; t < n_threads; t++)
+            threads.emplace_back(worker, t);
+        worker(0);
+    }
+
+    // 区間`[0, n)`を長さ`block`ごとに区切り、各区間について`f(first, last, thread_id)`を呼ぶ
+    // 1要素あたりの処理が軽い場合に、共有カウンタへのアクセスを減らすために用いる
+    template <class F>
+        requires std::invocable<F &, std::size_t, std::size_t, std::size_t>
+    void parallel_for_blocks(std::size_t n, std::size_t n_threads, std::size_t block, F &&f)
+    {
+        block = std::max<std::size_t>(block, 1);
+        const auto n_blocks = (n + block - 1) / block;
+        parallel_for(n_blocks, n_threads,
+                     [&](std::size_t b, std::size_t thread_id)
+                     { f(b * block, std::min(n, (b + 1) * block), thread_id); });
+    }
+
+    // 同じスレッドの組で`parallel_for`を繰り返し実行するためのワーカー
+    // 段ごとに並列処理を行うアルゴリズムで、段ごとにスレッドを生成・合流する費用を避けるために使う
+    // `run`では呼び出し元のスレッドも`thread_id = 0`として作業に加わり、全てのタスクが終わるまで戻らない
+    // `run`を複数のスレッドから同時に呼んではならない
+    class WorkerGroup
+    {
+    public:
+        // 呼び出し元を含めて`n_threads`本のスレッドで処理する（`n_threads - 1`本のスレッドを生成する）
+        explicit WorkerGroup(std::size_t n_threads) : n_threads_(std::max<std::size_t>(n_threads, 1))
+        {
+            threads_.reserve(n_threads_ - 1);
+            for (std::size_t t = 1; t < n_threads_; t++)
+                threads_.emplace_back([this, t]
+                                      { work(t); });
+        }
+
+        WorkerGroup(const WorkerGroup &) = delete;
+        WorkerGroup &operator=(const WorkerGroup &) = delete;
+
+        ~WorkerGroup()
+        {
+            {
+                std::lock_guard lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_all();
+            threads_.clear();
+        }
+
+        std::size_t size() const { return n_threads_; }
+
+        // `parallel_for(n_tasks, size(), f)`と同じ処理を、生成済みのスレッドで行う
+        template <class F>
+            requires std::invocable<F &, std::size_t, std::size_t>
+        void run(std::size_t n_tasks, F &&f)
+        {
+            if (n_threads_ == 1 || n_tasks <= 1)
+            {
+                for (std::size_t i = 0; i < n_tasks; i++)
+                    f(i, std::size_t{0});
+                return;
+            }
+
+            std::atomic<std::size_t> next{0};
+            auto worker = [&](std::size_t thread_id)
+            {
+                for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < n_tasks;
+                     i = next.fetch_add(1, std::memory_order_relaxed))
+                    f(i, thread_id);
+            };
+            {
+                std::lock_guard lock(mutex_);
+                job_ = &worker;
+                invoke_ = [](void *job, std::size_t thread_id)
+                { (*static_cast<decltype(worker) *>(job))(thread_id); };
+                running_ = threads_.size();
+                generation_++;
+            }
+            wake_.notify_all();
+            worker(0);
+            std::unique_lock lock(mutex_);
+            done_.wait(lock, [&]
+                       { return running_ == 0; });
+        }
+
+        // `parallel_for_blocks(n, size(), block, f)`と同じ処理を、生成済みのスレッドで行う
+        template <class F>
+            requires std::invocable<F &, std::size_t, std::size_t, std::size_t>
+        void run_blocks(std::size_t n, std::size_t block, F &&f)
+        {
+            block = std::max<std::size_t>(block, 1);
+            const auto n_blocks = (n + block - 1) / block;
+            run(n_blocks, [&](std::size_t b, std::size_t thread_id)
+                { f(b * block, std::min(n, (b + 1) * block), thread_id); });
+        }
+
+    private:
+        std::size_t n_threads_;
+        std::mutex mutex_;
+        std::condition_variable wake_, done_;
+        // 実行中の仕事（`run`の中の`worker`）とその呼び出し方
+        void *job_ = nullptr;
+        void (*invoke_)(void *, std::size_t) = nullptr;
+        std::size_t generation_ = 0, running_ = 0;
+        bool stop_ = false;
+        // 他のメンバより先に破棄（合流）されるよう最後に宣言する
+        std::vector<std::jthread> threads_;
+
+        void work(std::size_t thread_id)
+        {
+            std::size_t seen = 0;
+            while (true)
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, [&]
+                           { return stop_ || generation_ != seen; });
+                if (stop_)
+                    return;
+                seen = generation_;
+                const auto job = job_;
+                const auto invoke = invoke_;
+                lock.unlock();
+                invoke(job, thread_id);
+                lock.lock();
+                if (--running_ == 0)
+                    done_.notify_one();
+            }
+        }
+    };
+}
@@ -1,10 +1,24 @@
+#pragma once
 #include <vector>
+#include <array>
+#include <bit>
 #include <ranges>
-#include <queue>
 #include <utility>
 #include <algorithm>
+#include <numeric>
 #include <functional>
+#include <concepts>
+#include <cassert>
+#include <type_traits>
+#include <span>
+#include <map>
+#include <deque>
+#include <atomic>
+#include <cstdint>
 #include "../concepts/graph_concepts.hpp"
+#include "../data-structure/indexed_dary_heap.hpp"
+#include "../data-structure/csr_graph.hpp"
+#include "parallel.hpp"
 
 namespace gcl
 {
@@ -22,6 +36,26 @@ namespace gcl
 
     inline constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
 
+    // `parent`をたどって`start`から`goal`への頂点列を返す。到達不能なら空列を返す
+    inline std::vector<std::size_t> path_from_parent(const std::vector<std::size_t> &parent,
+                                                     std::size_t start, std::size_t goal)
+    {
+        if (goal >= parent.size())
+            return {};
+        std::vector<std::size_t>
+            path;
+        for (auto v = goal; v != npos; v = parent[v])
+        {
+            path.push_back(v);
+            if (v == start)
+                break;
+        }
+        if (path.empty() || path.back() != start)
+            return {};
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
     template <typename W>
     struct DijkstraResult
     {
@@ -35,20 +69,7 @@ namespace gcl
 
         std::vector<std::size_t> restore_path(std::size_t goal) const
         {
-            if (goal >= parent.size())
-                return {};
-            std::vector<std::size_t>
-                path;
-            for (auto v = goal; v != npos; v = parent[v])
-            {
-                path.push_back(v);
-                if (v == start)
-                    break;
-            }
-            if (path.empty() || path.back() != start)
-                return {};
-            std::reverse(path.begin(), path.end());
-            return path;
+            return path_from_parent(parent, start, goal);
         }
     };
 
@@ -64,38 +85,298 @@ namespace gcl
         void relax(std::size_t to, std::size_t from) noexcept { parent[to] = from; }
     };
 
-    template <typename C, typename ParentPolicy>
-        requires WeightedGraph<C>
-    std::vector<weight_t<C>> dijkstra_impl(const C &graph, std::size_t start, ParentPolicy &pp)
+    // Dijkstra法で用いる優先度付きキューが満たすべきコンセプト
+    // `push(d, v)`で距離`d`の頂点`v`を追加し、`pop()`で距離が最小の組を取り出す
+    template <typename Q, typename W>
+    concept DijkstraQueue =
+        requires(Q q, W d, std::size_t v) {
+            q.push(d, v);
+            { q.pop() } -> std::same_as<std::pair<W, std::size_t>>;
+            { q.empty() } -> std::convertible_to<bool>;
+            q.clear();
+        };
+
+    // 二分ヒープによるキュー。任意の`Weight`に使える
+    template <typename W>
+    class BinaryHeapQueue
+    {
+    public:
+        void push(W d, std::size_t v)
+        {
+            heap_.emplace_back(std::move(d), v);
+            std::push_heap(heap_.begin(), heap_.end(), std::greater<>{});
+        }
+
+        std::pair<W, std::size_t> pop()
+        {
+            std::pop_heap(heap_.begin(), heap_.end(), std::greater<>{});
+            auto top = std::move(heap_.back());
+            heap_.pop_back();
+            return top;
+        }
+
+        bool empty() const { return heap_.empty(); }
+        void clear() { heap_.clear(); }
+
+    private:
+        std::vector<std::pair<W, std::size_t>> heap_;
+    };
+
+    // Radix heap。整数の重み専用で、取り出す値が単調非減少であることを仮定する
+    // 各要素はバケットを高々`W`のビット数回しか移動しないため、ならしO(log C)で動作する
+    template <std::integral W>
+    class RadixHeapQueue
+    {
+        using U = std::make_unsigned_t<W>;
+        static constexpr int BITS = std::numeric_limits<U>::digits;
+
+    public:
+        void push(W d, std::size_t v)
+        {
+            const auto key = static_cast<U>(d);
+            assert(d >= W{} && key >= last_);
+            buckets_[bucket_of(key)].emplace_back(key, v);
+            size_++;
+        }
+
+        std::pair<W, std::size_t> pop()
+        {
+            assert(size_ > 0);
+            if (buckets_[0].empty())
+            {
+                auto i = std::size_t{1};
+                while (buckets_[i].empty())
+                    i++;
+                last_ = std::ranges::min_element(buckets_[i], {}, &std::pair<U, std::size_t>::first)->first;
+                for (const auto &entry : buckets_[i])
+                    buckets_[bucket_of(entry.first)].push_back(entry);
+                buckets_[i].clear();
+            }
+            auto [key, v] = buckets_[0].back();
+            buckets_[0].pop_back();
+            size_--;
+            return {static_cast<W>(key), v};
+        }
+
+        bool empty() const { return size_ == 0; }
+
+        void clear()
+        {
+            for (auto &bucket : buckets_)
+                bucket.clear();
+            last_ = 0;
+            size_ = 0;
+        }
+
+    private:
+        std::array<std::vector<std::pair<U, std::size_t>>, BITS + 1> buckets_;
+        U last_ = 0;
+        std::size_t size_ = 0;
+
+        std::size_t bucket_of(U key) const { return static_cast<std::size_t>(std::bit_width(static_cast<U>(key ^ last_))); }
+    };
+
+    // Dial法のバケットキュー。辺の重みが`max_weight`以下の非負整数であることを仮定する
+    // 距離`d`の頂点は`d mod (max_weight + 1)`番目のバケットに入るため、メモリはO(max_weight + V)
+    template <std::integral W>
+    class DialQueue
+    {
+    public:
+        explicit DialQueue(W max_weight) : buckets_(static_cast<std::size_t>(max_weight) + 1)
+        {
+            assert(max_weight >= W{});
+        }
+
+        void push(W d, std::size_t v)
+        {
+            assert(d >= current_ && static_cast<std::size_t>(d - current_) < buckets_.size());
+            buckets_[static_cast<std::size_t>(d) % buckets_.size()].push_back(v);
+            size_++;
+        }
+
+        std::pair<W, std::size_t> pop()
+        {
+            assert(size_ > 0);
+            while (buckets_[static_cast<std::size_t>(current_) % buckets_.size()].empty())
+                current_++;
+            auto &bucket = buckets_[static_cast<std::size_t>(current_) % buckets_.size()];
+            auto v = bucket.back();
+            bucket.pop_back();
+            size_--;
+            return {current_, v};
+        }
+
+        bool empty() const { return size_ == 0; }
+
+        void clear()
+        {
+            if (size_ > 0)
+            {
+                for (auto &bucket : buckets_)
+                    bucket.clear();
+            }
+            current_ = W{};
+            size_ = 0;
+        }
+
+    private:
+        std::vector<std::vector<std::size_t>> buckets_;
+        W current_{};
+        std::size_t size_ = 0;
+    };
+
+    // `IndexedDaryHeap`によるキュー。同じ頂点は高々1つしか入らず、既に入っていれば鍵を減少させる
+    // そのためキューの大きさは頂点数`n_vertices`を超えない
+    template <typename W, std::size_t Arity = 4>
+    class IndexedHeapQueue
+    {
+    public:
+        explicit IndexedHeapQueue(std::size_t n_vertices) : heap_(n_vertices) {}
+
+        void push(W d, std::size_t v) { heap_.push_or_decrease(v, std::move(d)); }
+        std::pair<W, std::size_t> pop() { return heap_.pop(); }
+        bool empty() const { return heap_.empty(); }
+        void clear() { heap_.clear(); }
+
+    private:
+        IndexedDaryHeap<W, Arity> heap_;
+    };
+
+    // 重み型`W`から既定のキューを選ぶ。整数なら`RadixHeapQueue`、それ以外は`BinaryHeapQueue`
+    template <typename W>
+    struct default_dijkstra_queue
+    {
+        using type = BinaryHeapQueue<W>;
+    };
+
+    template <std::integral W>
+    struct default_dijkstra_queue<W>
+    {
+        using type = RadixHeapQueue<W>;
+    };
+
+    template <typename W>
+    using default_dijkstra_queue_t = typename default_dijkstra_queue<W>::type;
+
+    // Dijkstra法の本体。`dist`は長さが頂点数で、全ての要素が`std::numeric_limits<W>::max()`である必要がある
+    // `target`を指定した場合、`target`の距離が確定した時点で探索を打ち切る
+    template <typename C, typename ParentPolicy, typename Queue>
+        requires WeightedGraph<C> && DijkstraQueue<Queue, weight_t<C>>
+    void dijkstra_run(const C &graph, std::size_t start, std::vector<weight_t<C>> &dist,
+                      ParentPolicy &pp, Queue &pq, std::size_t target = npos)
     {
         using W = weight_t<C>;
-        using Pair = std::pair<W, std::size_t>;
-        constexpr W INF = std::numeric_limits<W>::max();
 
-        std::vector<W> dist(std::ranges::size(graph), INF);
-        std::priority_queue<Pair, std::vector<Pair>, std::greater<>> pq;
+        pq.clear();
         dist[start] = W{};
-        pq.push({W{}, start});
+        pq.push(W{}, start);
         while (!pq.empty())
         {
-            auto [d, v] = pq.top();
-            pq.pop();
+            auto [d, v] = pq.pop();
 
             if (dist[v] < d)
                 continue;
+            if (v == target)
+                break;
             for (auto &&e : graph[v])
             {
                 W nd = d + static_cast<W>(e.weight);
                 if (chmin(dist[e.to], nd))
                 {
                     pp.relax(e.to, v);
-                    pq.push({nd, e.to});
+                    pq.push(nd, e.to);
                 }
             }
         }
+    }
+
+    template <typename C, typename ParentPolicy, typename Queue>
+        requires WeightedGraph<C> && DijkstraQueue<Queue, weight_t<C>>
+    std::vector<weight_t<C>> dijkstra_impl(const C &graph, std::size_t start, ParentPolicy &pp, Queue &pq,
+                                           std::size_t target = npos)
+    {
+        using W = weight_t<C>;
+        constexpr W INF = std::numeric_limits<W>::max();
+
+        std::vector<W> dist(std::ranges::size(graph), INF);
+        dijkstra_run(graph, start, dist, pp, pq, target);
         return dist;
     }
 
+    template <typename C, typename ParentPolicy>
+        requires WeightedGraph<C>
+    std::vector<weight_t<C>> dijkstra_impl(const C &graph, std::size_t start, ParentPolicy &pp)
+    {
+        default_dijkstra_queue_t<weight_t<C>> pq;
+        return dijkstra_impl(graph, start, pp, pq);
+    }
+
+    // 同じグラフに対して何度もDijkstra法を実行するための作業領域
+    // 距離・親・キューの領域を使い回し、前回の探索で触れた頂点だけを初期化するため、
+    // 2回目以降の探索は頂点数ではなく訪れた頂点数に比例する時間で済む
+    template <typename W, typename Queue = default_dijkstra_queue_t<W>>
+        requires DijkstraQueue<Queue, W>
+    class DijkstraWorkspace
+    {
+    public:
+        static constexpr W INF = std::numeric_limits<W>::max();
+
+        explicit DijkstraWorkspace(std::size_t n_vertices, Queue pq = Queue{})
+            : dist_(n_vertices, INF), parent_(n_vertices, npos), pq_(std::move(pq)) {}
+
+        // 直前の探索で触れた頂点の距離と親を初期状態に戻す
+        void reset()
+        {
+            for (auto v : touched_)
+            {
+                dist_[v] = INF;
+                parent_[v] = npos;
+            }
+            touched_.clear();
+            pq_.clear();
+            start_ = npos;
+        }
+
+        // `start`から探索する。前回の結果は`reset()`により破棄される
+        template <typename C>
+            requires WeightedGraph<C> && std::same_as<weight_t<C>, W>
+        void run(const C &graph, std::size_t start, std::size_t target = npos)
+        {
+            assert(std::ranges::size(graph) == dist_.size());
+            reset();
+            start_ = start;
+            touched_.push_back(start);
+            dijkstra_run(graph, start, dist_, *this, pq_, target);
+        }
+
+        // `dijkstra_run`から呼ばれる。初めて距離が更新された頂点を記録する
+        void relax(std::size_t to, std::size_t from)
+        {
+            if (parent_[to] == npos)
+                touched_.push_back(to);
+            parent_[to] = from;
+        }
+
+        std::size_t size() const { return dist_.size(); }
+        std::size_t start() const { return start_; }
+        const std::vector<W> &dist() const { return dist_; }
+        const std::vector<std::size_t> &parent() const { return parent_; }
+        // 直前の探索で距離が有限になった頂点
+        const std::vector<std::size_t> &touched() const { return touched_; }
+
+        std::vector<std::size_t> restore_path(std::size_t goal) const
+        {
+            return path_from_parent(parent_, start_, goal);
+        }
+
+    private:
+        std::vector<W> dist_;
+        std::vector<std::size_t> parent_;
+        std::vector<std::size_t> touched_;
+        Queue pq_;
+        std::size_t start_ = npos;
+    };
+
     // Dijkstra: edge weights must be non-negative, return only distance
     template <typename C>
         requires WeightedGraph<C>
@@ -105,6 +386,15 @@ namespace gcl
         return dijkstra_impl(graph, start, pp);
     }
 
+    // Dijkstra: `pq` selects the priority queue (e.g. `DialQueue<W>(max_weight)`)
+    template <typename C, typename Queue>
+        requires WeightedGraph<C> && DijkstraQueue<std::remove_cvref_t<Queue>, weight_t<C>>
+    std::vector<weight_t<C>> dijkstra_dist(const C &graph, std::size_t start, Queue &&pq)
+    {
+        NoParent pp;
+        return dijkstra_impl(graph, start, pp, pq);
+    }
+
     // Dijkstra: edge weights must be non-negative, return distance and parent
     template <typename C>
         requires WeightedGraph<C>
@@ -115,6 +405,338 @@ namespace gcl
         return {start, std::move(dist), std::move(pp.parent)};
     }
 
+    // Dijkstra: `pq` selects the priority queue (e.g. `DialQueue<W>(max_weight)`)
+    template <typename C, typename Queue>
+        requires WeightedGraph<C> && DijkstraQueue<std::remove_cvref_t<Queue>, weight_t<C>>
+    DijkstraResult<weight_t<C>> dijkstra_path(const C &graph, std::size_t start, Queue &&pq)
+    {
+        WithParent pp(std::ranges::size(graph));
+        auto dist = dijkstra_impl(graph, start, pp, pq);
+        return {start, std::move(dist), std::move(pp.parent)};
+    }
+
+    // Dijkstra (point-to-point): stop as soon as `goal` is settled.
+    // `dist[goal]` and `restore_path(goal)` are exact; other entries are exact only for settled vertices.
+    template <typename C>
+        requires WeightedGraph<C>
+    DijkstraResult<weight_t<C>> dijkstra_st(const C &graph, std::size_t start, std::size_t goal)
+    {
+        return dijkstra_st(graph, start, goal, default_dijkstra_queue_t<weight_t<C>>{});
+    }
+
+    template <typename C, typename Queue>
+        requires WeightedGraph<C> && DijkstraQueue<std::remove_cvref_t<Queue>, weight_t<C>>
+    DijkstraResult<weight_t<C>> dijkstra_st(const C &graph, std::size_t start, std::size_t goal, Queue &&pq)
+    {
+        WithParent pp(std::ranges::size(graph));
+        auto dist = dijkstra_impl(graph, start, pp, pq, goal);
+        return {start, std::move(dist), std::move(pp.parent)};
+    }
+
+    // Dijkstra with a reusable workspace: the result stays in `ws` until its next use
+    template <typename C, typename Queue>
+        requires WeightedGraph<C>
+    const std::vector<weight_t<C>> &dijkstra_dist(const C &graph, std::size_t start,
+                                                  DijkstraWorkspace<weight_t<C>, Queue> &ws)
+    {
+        ws.run(graph, start);
+        return ws.dist();
+    }
+
+    template <typename C, typename Queue>
+        requires WeightedGraph<C>
+    const DijkstraWorkspace<weight_t<C>, Queue> &dijkstra_path(const C &graph, std::size_t start,
+                                                               DijkstraWorkspace<weight_t<C>, Queue> &ws)
+    {
+        ws.run(graph, start);
+        return ws;
+    }
+
+    template <typename C, typename Queue>
+        requires WeightedGraph<C>
+    const DijkstraWorkspace<weight_t<C>, Queue> &dijkstra_st(const C &graph, std::size_t start, std::size_t goal,
+                                                             DijkstraWorkspace<weight_t<C>, Queue> &ws)
+    {
+        ws.run(graph, start, goal);
+        return ws;
+    }
+
+    // 複数始点のDijkstra。`sources[i]`からの距離配列を`f(i, dist)`に渡す
+    // `f`は`n_threads`本のワーカースレッドから並行に呼ばれるため、スレッド安全である必要がある
+    // `dist`は`f`の呼び出し中のみ有効である
+    template <typename C, typename F>
+        requires WeightedGraph<C> && std::invocable<F &, std::size_t, const std::vector<weight_t<C>> &>
+    void dijkstra_many(const C &graph, std::span<const std::size_t> sources, F &&f,
+                       std::size_t n_threads = default_thread_count())
+    {
+        using W = weight_t<C>;
+        const auto N = std::ranges::size(graph);
+        n_threads = std::clamp<std::size_t>(n_threads, 1, std::max<std::size_t>(sources.size(), 1));
+
+        // スレッドごとに1つの作業領域を持つ
+        std::vector<DijkstraWorkspace<W>> workspaces(n_threads, DijkstraWorkspace<W>(N));
+        parallel_for(sources.size(), n_threads,
+                     [&](std::size_t i, std::size_t thread_id)
+                     {
+                         auto &ws = workspaces[thread_id];
+                         ws.run(graph, sources[i]);
+                         f(i, ws.dist());
+                     });
+    }
+
+    // 複数始点のDijkstra。`sources[i]`から頂点`v`への距離を`out[i * N + v]`に書き込む（`N`は頂点数）
+    // `out`の長さは`sources.size() * N`以上である必要がある
+    template <typename C>
+        requires WeightedGraph<C>
+    void dijkstra_many(const C &graph, std::span<const std::size_t> sources, std::span<weight_t<C>> out,
+                       std::size_t n_threads = default_thread_count())
+    {
+        const auto N = std::ranges::size(graph);
+        assert(out.size() >= sources.size() * N);
+        dijkstra_many(
+            graph, sources,
+            [&](std::size_t i, const std::vector<weight_t<C>> &dist)
+            { std::ranges::copy(dist, out.begin() + static_cast<std::ptrdiff_t>(i * N)); },
+            n_threads);
+    }
+
+    // Delta-stepping法による並列な単一始点最短経路。辺の重みは非負である必要がある
+    // 距離を幅`delta`のバケットに分け、同じバケット内の頂点を`n_threads`本のスレッドで同時に処理する
+    // 返り値は`dijkstra_dist(graph, start)`と同じ距離配列である
+    template <typename C>
+        requires WeightedGraph<C> && std::is_arithmetic_v<weight_t<C>>
+    std::vector<weight_t<C>> delta_stepping(const C &graph, std::size_t start, weight_t<C> delta,
+                                            std::size_t n_threads = default_thread_count())
+    {
+        using W = weight_t<C>;
+        constexpr W INF = std::numeric_limits<W>::max();
+        // これより小さい頂点集合は逐次に処理する（ワーカーとの同期の費用の方が大きいため）
+        constexpr std::size_t PARALLEL_THRESHOLD = 1024;
+        constexpr std::size_t BLOCK = 256;
+        assert(delta > W{});
+
+        const auto N = std::ranges::size(graph);
+        n_threads = std::max<std::size_t>(n_threads, 1);
+        std::vector<W> dist(N, INF);
+        auto bucket_of = [&](W d)
+        { return static_cast<std::size_t>(d / delta); };
+
+        // 複数スレッドから呼ばれる。距離を更新した場合`true`を返す
+        auto relax = [&](std::size_t to, W nd) -> bool
+        {
+            std::atomic_ref<W> ref(dist[to]);
+            W cur = ref.load(std::memory_order_relaxed);
+            while (nd < cur)
+            {
+                if (ref.compare_exchange_weak(cur, nd, std::memory_order_relaxed))
+                    return true;
+            }
+            return false;
+        };
+
+        // `vertices`の各頂点から、`light`なら重み`delta`以下の辺を、そうでなければそれより重い辺を緩和する
+        // 距離が更新された頂点はスレッドごとに`updated`へ記録する
+        // スレッドはバケットの段ごとに作り直さず、全体を通して同じものを使う
+        std::vector<std::vector<std::size_t>> updated(n_threads);
+        WorkerGroup workers(n_threads);
+        auto relax_from = [&](const std::vector<std::size_t> &vertices, bool light)
+        {
+            auto relax_block = [&](std::size_t first, std::size_t last, std::size_t thread_id)
+            {
+                for (auto i = first; i < last; i++)
+                {
+                    const auto v = vertices[i];
+                    const W d = std::atomic_ref<W>(dist[v]).load(std::memory_order_relaxed);
+                    for (auto &&e : graph[v])
+                    {
+                        const W w = static_cast<W>(e.weight);
+                        if ((w <= delta) == light && relax(e.to, d + w))
+                            updated[thread_id].push_back(e.to);
+                    }
+                }
+            };
+            if (vertices.size() < PARALLEL_THRESHOLD)
+                relax_block(0, vertices.size(), 0);
+            else
+                workers.run_blocks(vertices.size(), BLOCK, relax_block);
+        };
+
+        std::map<std::size_t, std::vector<std::size_t>> buckets;
+        std::vector<std::uint8_t> in_frontier(N, 0), in_settled(N, 0);
+        dist[start] = W{};
+        buckets[0].push_back(start);
+
+        std::vector<std::size_t> frontier, settled;
+        while (!buckets.empty())
+        {
+            auto node = buckets.extract(buckets.begin());
+            const auto current = node.key();
+
+            // バケットには古い要素や重複が含まれるので取り除く
+            frontier.clear();
+            for (auto v : node.mapped())
+            {
+                if (bucket_of(dist[v]) == current && !in_frontier[v])
+                {
+                    in_frontier[v] = 1;
+                    frontier.push_back(v);
+                }
+            }
+
+            settled.clear();
+            while (!frontier.empty())
+            {
+                for (auto v : frontier)
+                {
+                    in_frontier[v] = 0;
+                    if (!in_settled[v])
+                    {
+                        in_settled[v] = 1;
+                        settled.push_back(v);
+                    }
+                }
+                relax_from(frontier, true);
+
+                // 同じバケットに入った頂点は次の frontier に、それ以外は後のバケットに入れる
+                frontier.clear();
+                for (auto &list : updated)
+                {
+                    for (auto v : list)
+                    {
+                        const auto b = bucket_of(dist[v]);
+                        if (b != current)
+                            buckets[b].push_back(v);
+                        else if (!in_frontier[v])
+                        {
+                            in_frontier[v] = 1;
+                            frontier.push_back(v);
+                        }
+                    }
+                    list.clear();
+                }
+            }
+
+            // 重い辺はバケット内の距離が確定してから一度だけ緩和すればよい
+            relax_from(settled, false);
+            for (auto &list : updated)
+            {
+                for (auto v : list)
+                    buckets[bucket_of(dist[v])].push_back(v);
+                list.clear();
+            }
+            for (auto v : settled)
+                in_settled[v] = 0;
+        }
+        return dist;
+    }
+
+    // 双方向Dijkstra。`reverse`は`graph`の全ての辺を逆向きにしたグラフである必要がある。
+    // 始点側と終点側から交互に探索し、両側の確定距離の和が暫定の最短距離以上になった時点で打ち切る。
+    // 返り値の`dist[goal]`と`restore_path(goal)`は正確だが、それ以外の要素は前向き探索で確定した頂点のみ正確である。
+    template <typename C, typename R, typename Queue>
+        requires WeightedGraph<C> && WeightedGraph<R> && std::same_as<weight_t<C>, weight_t<R>> &&
+                 DijkstraQueue<std::remove_cvref_t<Queue>, weight_t<C>>
+    DijkstraResult<weight_t<C>> bidirectional_dijkstra(const C &graph, const R &reverse,
+                                                       std::size_t start, std::size_t goal, Queue &&pq)
+    {
+        using W = weight_t<C>;
+        constexpr W INF = std::numeric_limits<W>::max();
+        const auto N = std::ranges::size(graph);
+        assert(std::ranges::size(reverse) == N);
+
+        std::vector<W> dist_f(N, INF), dist_b(N, INF);
+        std::vector<std::size_t> parent_f(N, npos), parent_b(N, npos);
+        std::remove_cvref_t<Queue> pq_f = pq, pq_b = pq;
+        pq_f.clear();
+        pq_b.clear();
+
+        W best = (start == goal) ? W{} : INF;
+        std::size_t meet = (start == goal) ? start : npos;
+        dist_f[start] = W{};
+        dist_b[goal] = W{};
+        pq_f.push(W{}, start);
+        pq_b.push(W{}, goal);
+
+        // 片側を1頂点だけ確定させる。確定させる頂点が無ければ`false`を返す
+        auto step = [&](const auto &g, auto &q, std::vector<W> &dist, std::vector<std::size_t> &parent,
+                        const std::vector<W> &other, W &settled) -> bool
+        {
+            while (!q.empty())
+            {
+                auto [d, v] = q.pop();
+                if (dist[v] < d)
+                    continue;
+                settled = d;
+                for (auto &&e : g[v])
+                {
+                    W nd = d + static_cast<W>(e.weight);
+                    if (chmin(dist[e.to], nd))
+                    {
+                        parent[e.to] = v;
+                        q.push(nd, e.to);
+                        if (other[e.to] != INF && chmin(best, nd + other[e.to]))
+                            meet = e.to;
+                    }
+                }
+                return true;
+            }
+            return false;
+        };
+
+        W settled_f{}, settled_b{};
+        while (true)
+        {
+            if (!step(graph, pq_f, dist_f, parent_f, dist_b, settled_f))
+                break;
+            if (best != INF && settled_f + settled_b >= best)
+                break;
+            if (!step(reverse, pq_b, dist_b, parent_b, dist_f, settled_b))
+                break;
+            if (best != INF && settled_f + settled_b >= best)
+                break;
+        }
+
+        if (meet == npos)
+            return {start, std::move(dist_f), std::move(parent_f)};
+
+        // start -> meet -> goal の頂点列を作る。重み0の閉路を含む場合は取り除く
+        std::vector<std::size_t> path;
+        for (auto v = meet; v != npos; v = parent_f[v])
+            path.push_back(v);
+        std::reverse(path.begin(), path.end());
+        for (auto v = parent_b[meet]; v != npos; v = parent_b[v])
+            path.push_back(v);
+
+        auto &index = parent_b; // 以降は頂点の path 上の位置として使い回す
+        std::fill(index.begin(), index.end(), npos);
+        std::vector<std::size_t> simple;
+        for (auto v : path)
+        {
+            if (index[v] != npos)
+            {
+                for (auto i = index[v] + 1; i < simple.size(); i++)
+                    index[simple[i]] = npos;
+                simple.resize(index[v] + 1);
+                continue;
+            }
+            index[v] = simple.size();
+            simple.push_back(v);
+        }
+
+        for (std::size_t i = 1; i < simple.size(); i++)
+            parent_f[simple[i]] = simple[i - 1];
+        dist_f[goal] = best;
+        return {start, std::move(dist_f), std::move(parent_f)};
+    }
+
+    template <typename C, typename R>
+        requires WeightedGraph<C> && WeightedGraph<R> && std::same_as<weight_t<C>, weight_t<R>>
+    DijkstraResult<weight_t<C>> bidirectional_dijkstra(const C &graph, const R &reverse,
+                                                       std::size_t start, std::size_t goal)
+    {
+        return bidirectional_dijkstra(graph, reverse, start, goal, default_dijkstra_queue_t<weight_t<C>>{});
+    }
+
     template <typename W>
     struct BellmanFordResult
     {
@@ -152,4 +774,270 @@ namespace gcl
         }
         return BellmanFordResult{std::move(dist), negative_cycle_exist};
     }
+
+    template <typename W>
+    struct SPFAResult
+    {
+        std::vector<W> dist;
+        bool negative_cycle_exist;
+        // 始点から到達可能な負閉路の1つ。`negative_cycle[i] -> negative_cycle[i + 1]`（最後は先頭へ）の辺が存在する
+        std::vector<std::size_t> negative_cycle;
+    };
+
+    // キューを用いたBellman-Ford法（SPFA）。距離が更新された頂点から出る辺だけを緩和する
+    // キューの先頭より距離が小さい頂点は先頭に入れ（SLF）、平均より距離が大きい先頭の頂点は後ろに回す（LLL）
+    // 最短路の辺数が頂点数以上になった頂点は負閉路から到達可能であるため、そこから到達可能な頂点の距離を
+    // `std::numeric_limits<W>::lowest()`（負の無限大）とする
+    template <typename C>
+        requires WeightedGraph<C>
+    SPFAResult<weight_t<C>> spfa(const C &graph, std::size_t start)
+    {
+        using W = weight_t<C>;
+        constexpr W INF = std::numeric_limits<W>::max();
+        constexpr W NEG_INF = std::numeric_limits<W>::lowest();
+        const auto N = std::ranges::size(graph);
+
+        std::vector<W> dist(N, INF);
+        std::vector<std::size_t> parent(N, npos), length(N, 0), seen(N, npos);
+        // 負の無限大かどうか（`W`が符号なしの場合`NEG_INF`は 0 になり距離と区別できないため、別に持つ）
+        std::vector<std::uint8_t> in_queue(N, 0), negative(N, 0);
+        std::deque<std::size_t> dq;
+        std::vector<std::size_t> cycle;
+        bool negative_cycle_exist = false;
+
+        // LLL のためにキュー内（負の無限大でないもの）の距離の総和と個数を保持する
+        long double queued_sum = 0;
+        std::size_t queued = 0;
+        auto enqueue_sum = [&](W d, long double sign)
+        {
+            if constexpr (std::is_arithmetic_v<W>)
+                queued_sum += sign * static_cast<long double>(d);
+        };
+
+        // `x`から親をたどり、閉路が見つかればそれを`cycle`に格納する
+        auto find_cycle_from = [&](std::size_t x)
+        {
+            std::vector<std::size_t> chain;
+            for (auto v = x; v != npos; v = parent[v])
+            {
+                if (seen[v] == x)
+                {
+                    auto first = std::find(chain.begin(), chain.end(), v);
+                    cycle.assign(first, chain.end());
+                    std::reverse(cycle.begin(), cycle.end());
+                    break;
+                }
+                seen[v] = x;
+                chain.push_back(v);
+            }
+        };
+
+        // `x`から到達可能な頂点を全て負の無限大にする
+        auto mark_negative = [&](std::size_t x)
+        {
+            negative_cycle_exist = true;
+            if (cycle.empty())
+                find_cycle_from(x);
+            std::vector<std::size_t> stack{x};
+            if (in_queue[x])
+            {
+                enqueue_sum(dist[x], -1);
+                queued--;
+            }
+            dist[x] = NEG_INF;
+            negative[x] = 1;
+            while (!stack.empty())
+            {
+                auto v = stack.back();
+                stack.pop_back();
+                for (auto &&e : graph[v])
+                {
+                    if (negative[e.to])
+                        continue;
+                    if (in_queue[e.to] && dist[e.to] != INF)
+                    {
+                        enqueue_sum(dist[e.to], -1);
+                        queued--;
+                    }
+                    dist[e.to] = NEG_INF;
+                    negative[e.to] = 1;
+                    stack.push_back(e.to);
+                }
+            }
+        };
+
+        dist[start] = W{};
+        dq.push_back(start);
+        in_queue[start] = 1;
+        queued = 1;
+        while (!dq.empty())
+        {
+            if constexpr (std::is_arithmetic_v<W>)
+            {
+                for (auto rotate = dq.size(); rotate > 1 && queued > 0; rotate--)
+                {
+                    const auto front = dq.front();
+                    if (negative[front] ||
+                        static_cast<long double>(dist[front]) * static_cast<long double>(queued) <= queued_sum)
+                        break;
+                    dq.pop_front();
+                    dq.push_back(front);
+                }
+            }
+
+            const auto v = dq.front();
+            dq.pop_front();
+            in_queue[v] = 0;
+            if (negative[v])
+                continue;
+            enqueue_sum(dist[v], -1);
+            queued--;
+
+            for (auto &&e : graph[v])
+            {
+                if (negative[v])
+                    break;
+                const auto to = static_cast<std::size_t>(e.to);
+                if (negative[to])
+                    continue;
+                W nd = dist[v] + static_cast<W>(e.weight);
+                if (!(nd < dist[to]))
+                    continue;
+
+                if (in_queue[to])
+                    enqueue_sum(dist[to], -1);
+                dist[to] = nd;
+                parent[to] = v;
+                length[to] = length[v] + 1;
+                if (in_queue[to])
+                    enqueue_sum(nd, 1);
+
+                if (length[to] >= N)
+                {
+                    mark_negative(to);
+                    continue;
+                }
+                if (!in_queue[to])
+                {
+                    if (!dq.empty() && !negative[dq.front()] && nd < dist[dq.front()])
+                        dq.push_front(to);
+                    else
+                        dq.push_back(to);
+                    in_queue[to] = 1;
+                    enqueue_sum(nd, 1);
+                    queued++;
+                }
+            }
+        }
+
+        // 親をたどって閉路が見つからなかった場合は、負の無限大の頂点（全ての負閉路を含む）の上で
+        // Bellman-Ford法を行い、最後の反復で更新された頂点から閉路を取り出す
+        if (negative_cycle_exist && cycle.empty())
+        {
+            std::vector<std::size_t> members;
+            for (std::size_t v = 0; v < N; v++)
+            {
+                if (negative[v])
+                    members.push_back(v);
+            }
+            std::vector<W> d(N, W{});
+            std::fill(parent.begin(), parent.end(), npos);
+            auto last = npos;
+            for (std::size_t iter = 0; iter < members.size(); iter++)
+            {
+                last = npos;
+                for (auto u : members)
+                {
+                    for (auto &&e : graph[u])
+                    {
+                        if (negative[e.to] && chmin(d[e.to], d[u] + static_cast<W>(e.weight)))
+                        {
+                            parent[e.to] = u;
+                            last = e.to;
+                        }
+                    }
+                }
+                if (last == npos)
+                    break;
+            }
+            if (last != npos)
+            {
+                for (std::size_t i = 0; i < members.size(); i++)
+                    last = parent[last];
+                std::fill(seen.begin(), seen.end(), npos);
+                find_cycle_from(last);
+            }
+        }
+        return SPFAResult<W>{std::move(dist), negative_cycle_exist, std::move(cycle)};
+    }
+
+    // Johnson法による全点対最短経路。負辺を含んでも良い
+    // `bellman_ford`で求めたポテンシャル`h`で辺の重みを`w + h[u] - h[v]`（非負）に付け替え、各始点からDijkstra法を行う
+    // 頂点`u`からの距離配列を`f(u, dist)`に渡す。`f`は`n_threads`本のワーカースレッドから並行に呼ばれる
+    // 始点から到達可能かに関わらず負閉路が存在する場合は`f`を呼ばずに`false`を返す
+    template <typename C, typename F>
+        requires WeightedGraph<C> && (std::signed_integral<weight_t<C>> || std::floating_point<weight_t<C>>) &&
+                 std::invocable<F &, std::size_t, const std::vector<weight_t<C>> &>
+    bool johnson(const C &graph, F &&f, std::size_t n_threads = 1)
+    {
+        using W = weight_t<C>;
+        constexpr W INF = std::numeric_limits<W>::max();
+        const auto N = std::ranges::size(graph);
+
+        // 頂点`N`から全頂点へ重み0の辺を張ったグラフでポテンシャルを求める
+        std::vector<UWEdge<W>> edges;
+        for (std::size_t u = 0; u < N; u++)
+        {
+            for (auto &&e : graph[u])
+                edges.emplace_back(u, static_cast<std::size_t>(e.to), static_cast<W>(e.weight));
+        }
+        const auto n_original_edges = edges.size();
+        for (std::size_t v = 0; v < N; v++)
+            edges.emplace_back(N, v, W{});
+        auto [h, negative_cycle_exist] = bellman_ford(CSRGraph<W, std::size_t>(N + 1, edges), N);
+        if (negative_cycle_exist)
+            return false;
+
+        edges.resize(n_original_edges);
+        for (auto &e : edges)
+        {
+            e.weight = e.weight + h[e.from] - h[e.to];
+            if constexpr (std::floating_point<W>)
+                e.weight = std::max(e.weight, W{}); // 丸め誤差で負にならないようにする
+        }
+        const CSRGraph<W, std::size_t> reweighted(N, edges);
+        edges = {};
+
+        std::vector<std::size_t> sources(N);
+        std::iota(sources.begin(), sources.end(), std::size_t{0});
+        dijkstra_many(
+            reweighted, sources,
+            [&](std::size_t u, const std::vector<W> &dist)
+            {
+                std::vector<W> row(N, INF);
+                for (std::size_t v = 0; v < N; v++)
+                {
+                    if (dist[v] != INF)
+                        row[v] = dist[v] - h[u] + h[v];
+                }
+                f(u, row);
+            },
+            n_threads);
+        return true;
+    }
+
+    // Johnson法による全点対最短経路。`u`から`v`への距離を`out[u * N + v]`に書き込む（`N`は頂点数）
+    // 負閉路が存在する場合は何も書き込まずに`false`を返す
+    template <typename C>
+        requires WeightedGraph<C> && (std::signed_integral<weight_t<C>> || std::floating_point<weight_t<C>>)
+    bool johnson(const C &graph, std::span<weight_t<C>> out, std::size_t n_threads = 1)
+    {
+        const auto N = std::ranges::size(graph);
+        assert(out.size() >= N * N);
+        return johnson(
+            graph,
+            [&](std::size_t u, const std::vector<weight_t<C>> &dist)
+            { std::ranges::copy(dist, out.begin() + static_cast<std::ptrdiff_t>(u * N)); },
+            n_threads);
+    }
 }
\ No newline at end of file
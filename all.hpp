@@ -1,5 +1,20 @@
+#include "algorithm/parallel.hpp"
 #include "algorithm/shortest_path.hpp"
+#include "algorithm/bfs.hpp"
+#include "algorithm/floyd_warshall.hpp"
+#include "algorithm/minimum_spanning_tree.hpp"
+#include "algorithm/connected_components.hpp"
+#include "algorithm/offline_dynamic_connectivity.hpp"
+#include "algorithm/lca.hpp"
 #include "data-structure/graph.hpp"
+#include "data-structure/csr_graph.hpp"
+#include "data-structure/indexed_dary_heap.hpp"
 #include "data-structure/unionfind.hpp"
+#include "data-structure/concurrent_unionfind.hpp"
 #include "data-structure/fenwick_tree.hpp"
-#include "concepts/graph_concepts.hpp"
\ No newline at end of file
+#include "data-structure/treap.hpp"
+#include "data-structure/segment_tree.hpp"
+#include "data-structure/lazy_segment_tree.hpp"
+#include "data-structure/sparse_table.hpp"
+#include "concepts/graph_concepts.hpp"
+#include "concepts/algebra_concepts.hpp"
\ No newline at end of file
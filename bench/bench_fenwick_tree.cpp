@@ -0,0 +1,94 @@
+// Fenwick Tree の各実装の更新・区間和クエリの速度を比較する
+// usage: bench_fenwick_tree [n] [queries]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../data-structure/fenwick_tree.hpp"
+
+namespace
+{
+    template <class F>
+    void measure(const char *name, F &&f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto check = f();
+        const auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-36s %10.2f ms  (checksum %lld)\n", name, ms, static_cast<long long>(check));
+    }
+
+    // 1次元：一点加算と区間和を交互に行う
+    template <class Tree>
+    long long run_1d(std::size_t n, std::size_t queries)
+    {
+        Tree tree(std::vector<long long>(n, 1));
+        std::mt19937_64 rng(42);
+        long long check = 0;
+        for (std::size_t q = 0; q < queries; q++)
+        {
+            tree.add(rng() % n, 1);
+            auto l = rng() % n, r = rng() % n;
+            if (l > r)
+                std::swap(l, r);
+            check += tree.sum(l, r);
+        }
+        return check;
+    }
+
+    // 2次元：行ごとに`FenwickTree`を持つ従来の方法
+    long long run_rows(std::size_t h, std::size_t w, std::size_t queries)
+    {
+        std::vector<gcl::FenwickTree<long long>> rows(h, gcl::FenwickTree<long long>(std::vector<long long>(w, 1)));
+        std::mt19937_64 rng(42);
+        long long check = 0;
+        for (std::size_t q = 0; q < queries; q++)
+        {
+            rows[rng() % h].add(rng() % w, 1);
+            auto r0 = rng() % h, r1 = rng() % h, c0 = rng() % w, c1 = rng() % w;
+            if (r0 > r1)
+                std::swap(r0, r1);
+            if (c0 > c1)
+                std::swap(c0, c1);
+            for (auto i = r0; i < r1; i++)
+                check += rows[i].sum(c0, c1);
+        }
+        return check;
+    }
+
+    long long run_2d(std::size_t h, std::size_t w, std::size_t queries)
+    {
+        gcl::FenwickTreeND<long long, 2> tree({h, w}, std::vector<long long>(h * w, 1));
+        std::mt19937_64 rng(42);
+        long long check = 0;
+        for (std::size_t q = 0; q < queries; q++)
+        {
+            const auto i = rng() % h;
+            tree.add({i, rng() % w}, 1);
+            auto r0 = rng() % h, r1 = rng() % h, c0 = rng() % w, c1 = rng() % w;
+            if (r0 > r1)
+                std::swap(r0, r1);
+            if (c0 > c1)
+                std::swap(c0, c1);
+            check += tree.sum({r0, c0}, {r1, c1});
+        }
+        return check;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t{1} << 24;
+    const std::size_t queries = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::size_t{1} << 22;
+
+    std::printf("1D: n = %zu, queries = %zu\n", n, queries);
+    measure("FenwickTree", [&] { return run_1d<gcl::FenwickTree<long long>>(n, queries); });
+    measure("BlockedFenwickTree<16>", [&] { return run_1d<gcl::BlockedFenwickTree<long long, 16>>(n, queries); });
+    measure("BlockedFenwickTree<32>", [&] { return run_1d<gcl::BlockedFenwickTree<long long, 32>>(n, queries); });
+
+    // 行ごとの方式はクエリあたり O(H log W) なので、クエリ数を減らして比較する
+    const std::size_t side = 2048, queries_2d = queries / 64;
+    std::printf("2D: %zu x %zu, queries = %zu\n", side, side, queries_2d);
+    measure("FenwickTree per row", [&] { return run_rows(side, side, queries_2d); });
+    measure("FenwickTreeND<2>", [&] { return run_2d(side, side, queries_2d); });
+}
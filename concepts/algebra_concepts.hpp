@@ -0,0 +1,56 @@
+#pragma once
+#include <concepts>
+#include <type_traits>
+
+namespace gcl
+{
+    // 加減算が出来る値型`T`（`FenwickTree`の値型など）
+    // 演算子で値型そのものに制約を課す。結合律・可換性・逆元の性質は利用者が保証する必要がある
+    template <typename T>
+    concept ModuleLike =
+        std::default_initializable<T> &&
+        std::copyable<T> &&
+        requires(T a, T b) {
+            { a + b } -> std::same_as<T>;
+            { a - b } -> std::same_as<T>;
+            { a += b } -> std::same_as<T &>;
+            { a -= b } -> std::same_as<T &>;
+        };
+
+    // モノイドを表す型`M`
+    // - `M::value_type`：台集合の型
+    // - `M::identity()`：単位元
+    // - `M::op(a, b)`：結合的な二項演算
+    // 結合律・単位元の性質はコンセプトでは静的に検証されないため、利用者が保証する必要がある
+    template <typename M>
+    concept Monoid =
+        std::copyable<typename M::value_type> &&
+        requires(const typename M::value_type &a, const typename M::value_type &b) {
+            { M::identity() } -> std::convertible_to<typename M::value_type>;
+            { M::op(a, b) } -> std::convertible_to<typename M::value_type>;
+        };
+
+    // モノイド`M`の値に作用する作用素のモノイド`A`
+    // - `A::value_type`：作用素の型。`A::identity()`は恒等写像
+    // - `A::op(f, g)`：合成`f ∘ g`（`g`を作用させてから`f`を作用させる）
+    // - `A::act(f, x)`：`x`に`f`を作用させた値。`act(f, op(x, y)) == op(act(f, x), act(f, y))`を満たす必要がある
+    // 区間の長さが必要な作用（区間和への一様加算など）では、`M::value_type`に長さを持たせる
+    template <typename A, typename M>
+    concept MonoidAction =
+        Monoid<M> && Monoid<A> &&
+        requires(const typename A::value_type &f, const typename M::value_type &x) {
+            { A::act(f, x) } -> std::convertible_to<typename M::value_type>;
+        };
+
+    // 何もしない作用（遅延評価を使わない場合に用いる）
+    template <Monoid M>
+    struct NoAction
+    {
+        struct value_type
+        {
+        };
+        static constexpr value_type identity() { return {}; }
+        static constexpr value_type op(value_type, value_type) { return {}; }
+        static constexpr const typename M::value_type &act(value_type, const typename M::value_type &x) { return x; }
+    };
+}
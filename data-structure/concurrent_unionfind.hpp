@@ -0,0 +1,120 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+#include <limits>
+#include <utility>
+
+namespace gcl
+{
+    // 複数のスレッドから同時に操作できるUnionFind
+    // 各要素は根では`-(集合のサイズ)`、それ以外では親の番号を1つのアトミック変数に持つ
+    // 根同士は常に番号の大きい方を小さい方の下に繋ぐため、代表元は集合内の最小の要素番号になる
+    template <std::signed_integral Index = std::int32_t>
+    class ConcurrentUnionFind
+    {
+    public:
+        using index_type = Index;
+
+        /*
+            @brief n 要素のUnionFindを構築する
+        */
+        explicit ConcurrentUnionFind(std::size_t size) : _data(size)
+        {
+            assert(size <= static_cast<std::size_t>(std::numeric_limits<Index>::max()));
+            for (auto &x : _data)
+                x.store(-1, std::memory_order_relaxed);
+        }
+
+        // `id`の所属する集合の代表元を返す
+        // 経路半減は CAS で行い、失敗しても再試行しないため、有限回の手順で終わる（wait-free）
+        [[nodiscard]] std::size_t find(std::size_t id)
+        {
+            auto v = static_cast<Index>(id);
+            while (true)
+            {
+                auto p = _data[v].load(std::memory_order_acquire);
+                if (p < 0)
+                    return static_cast<std::size_t>(v);
+                auto gp = _data[p].load(std::memory_order_acquire);
+                if (gp < 0)
+                    return static_cast<std::size_t>(p);
+                _data[v].compare_exchange_weak(p, gp, std::memory_order_acq_rel, std::memory_order_relaxed);
+                v = gp;
+            }
+        }
+
+        // `id`の所属する集合のサイズを返す
+        // 他のスレッドが`unite`している最中は、結合前のサイズを返すことがある
+        [[nodiscard]] std::size_t size(std::size_t id)
+        {
+            while (true)
+            {
+                const auto root = find(id);
+                const auto s = _data[root].load(std::memory_order_acquire);
+                if (s < 0)
+                    return static_cast<std::size_t>(-s);
+            }
+        }
+
+        // `left`と`right`の所属する集合が等しいか返す
+        [[nodiscard]] bool same(std::size_t left, std::size_t right)
+        {
+            while (true)
+            {
+                const auto root_left = find(left);
+                const auto root_right = find(right);
+                if (root_left == root_right)
+                    return true;
+                // `root_left`が根のままなら、2つの`find`の間に結合されていない
+                if (_data[root_left].load(std::memory_order_acquire) < 0)
+                    return false;
+            }
+        }
+
+        // `left`と`right`の所属する集合を結合する
+        // 結合した場合は`true`、既に同じ集合であった場合は`false`を返す
+        bool unite(std::size_t left, std::size_t right)
+        {
+            while (true)
+            {
+                auto root_left = find(left);
+                auto root_right = find(right);
+                if (root_left == root_right)
+                    return false;
+                if (root_left > root_right)
+                    std::swap(root_left, root_right);
+
+                // 番号の大きい根`root_right`を、そのサイズを取り出しつつ`root_left`の下に繋ぐ
+                auto s = _data[root_right].load(std::memory_order_acquire);
+                if (s >= 0)
+                    continue;
+                if (!_data[root_right].compare_exchange_strong(s, static_cast<Index>(root_left),
+                                                               std::memory_order_acq_rel, std::memory_order_relaxed))
+                    continue;
+
+                // 取り出したサイズを現在の根に加算する（`root_left`が既に別の根の下に繋がれていれば辿る）
+                auto v = static_cast<Index>(root_left);
+                auto cur = _data[v].load(std::memory_order_acquire);
+                while (true)
+                {
+                    if (cur >= 0)
+                    {
+                        v = cur;
+                        cur = _data[v].load(std::memory_order_acquire);
+                        continue;
+                    }
+                    if (_data[v].compare_exchange_weak(cur, static_cast<Index>(cur + s),
+                                                       std::memory_order_acq_rel, std::memory_order_acquire))
+                        return true;
+                }
+            }
+        }
+
+    private:
+        std::vector<std::atomic<Index>> _data;
+    };
+}
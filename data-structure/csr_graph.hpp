@@ -0,0 +1,174 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <concepts>
+#include <iterator>
+#include <utility>
+#include "graph.hpp"
+
+namespace gcl
+{
+    // CSR（Compressed Sparse Row）形式の重み付き有向グラフ
+    // 頂点`u`の隣接辺は`to_[offset_[u]], ..., to_[offset_[u + 1] - 1]`に連続して格納される
+    template <typename W, std::unsigned_integral Index = std::uint32_t>
+    class CSRGraph
+    {
+    public:
+        using weight_type = W;
+        using index_type = Index;
+
+        // 頂点`u`の隣接辺レンジ。要素は`WEdge<W>`として値で返す
+        class AdjRange
+        {
+        public:
+            class iterator
+            {
+            public:
+                using value_type = WEdge<W>;
+                using difference_type = std::ptrdiff_t;
+
+                iterator() = default;
+                iterator(const CSRGraph *g, std::size_t pos) : g_(g), pos_(pos) {}
+
+                value_type operator*() const { return {static_cast<std::size_t>(g_->to_[pos_]), g_->weight_[pos_]}; }
+                iterator &operator++()
+                {
+                    ++pos_;
+                    return *this;
+                }
+                iterator operator++(int)
+                {
+                    auto tmp = *this;
+                    ++pos_;
+                    return tmp;
+                }
+                bool operator==(const iterator &other) const { return pos_ == other.pos_; }
+
+            private:
+                const CSRGraph *g_ = nullptr;
+                std::size_t pos_ = 0;
+            };
+
+            AdjRange(const CSRGraph *g, std::size_t first, std::size_t last) : g_(g), first_(first), last_(last) {}
+
+            iterator begin() const { return {g_, first_}; }
+            iterator end() const { return {g_, last_}; }
+            std::size_t size() const { return last_ - first_; }
+            bool empty() const { return first_ == last_; }
+
+        private:
+            const CSRGraph *g_;
+            std::size_t first_, last_;
+        };
+
+        // 頂点ごとの`AdjRange`を返すイテレータ（`std::ranges::sized_range`を満たすため）
+        class iterator
+        {
+        public:
+            using value_type = AdjRange;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            iterator(const CSRGraph *g, std::size_t v) : g_(g), v_(v) {}
+
+            value_type operator*() const { return (*g_)[v_]; }
+            iterator &operator++()
+            {
+                ++v_;
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++v_;
+                return tmp;
+            }
+            bool operator==(const iterator &other) const { return v_ == other.v_; }
+
+        private:
+            const CSRGraph *g_ = nullptr;
+            std::size_t v_ = 0;
+        };
+
+        CSRGraph() : offset_(1, std::size_t{0}) {}
+
+        // 隣接リスト`graph`を同じ辺順のままCSR形式に変換する
+        explicit CSRGraph(const WGraph<W> &graph) : offset_(graph.size() + 1, std::size_t{0})
+        {
+            for (std::size_t u = 0; u < graph.size(); u++)
+                offset_[u + 1] = offset_[u] + graph[u].size();
+            to_.reserve(offset_.back());
+            weight_.reserve(offset_.back());
+            for (const auto &adj : graph)
+            {
+                for (const auto &e : adj)
+                {
+                    assert(e.to < graph.size());
+                    to_.push_back(static_cast<Index>(e.to));
+                    weight_.push_back(e.weight);
+                }
+            }
+        }
+
+        // 辺集合から構築する。各辺は`from -> to`の有向辺として追加され、
+        // `undirected`が`true`のときは`to -> from`も追加される。
+        // 同じ始点を持つ辺は`edges`での出現順に並ぶ。
+        CSRGraph(std::size_t n_vertices, const std::vector<UWEdge<W>> &edges, bool undirected = false)
+            : offset_(n_vertices + 1, std::size_t{0})
+        {
+            // counting sort による2パス構築
+            for (const auto &e : edges)
+            {
+                assert(e.from < n_vertices && e.to < n_vertices);
+                offset_[e.from + 1]++;
+                if (undirected)
+                    offset_[e.to + 1]++;
+            }
+            for (std::size_t u = 0; u < n_vertices; u++)
+                offset_[u + 1] += offset_[u];
+
+            to_.resize(offset_.back());
+            weight_.resize(offset_.back());
+            std::vector<std::size_t> pos(offset_.begin(), offset_.end() - 1);
+            for (const auto &e : edges)
+            {
+                auto i = pos[e.from]++;
+                to_[i] = static_cast<Index>(e.to);
+                weight_[i] = e.weight;
+                if (undirected)
+                {
+                    auto j = pos[e.to]++;
+                    to_[j] = static_cast<Index>(e.from);
+                    weight_[j] = e.weight;
+                }
+            }
+        }
+
+        AdjRange operator[](std::size_t u) const
+        {
+            assert(u + 1 < offset_.size());
+            return {this, offset_[u], offset_[u + 1]};
+        }
+
+        iterator begin() const { return {this, 0}; }
+        iterator end() const { return {this, size()}; }
+
+        // 頂点数
+        std::size_t size() const { return offset_.size() - 1; }
+        // 有向辺の本数（無向辺として追加した辺は2本と数える）
+        std::size_t num_edges() const { return to_.size(); }
+        std::size_t degree(std::size_t u) const { return offset_[u + 1] - offset_[u]; }
+
+        // 内部配列への直接アクセス（辺番号`i`は`offsets()[u] <= i < offsets()[u + 1]`）
+        const std::vector<std::size_t> &offsets() const { return offset_; }
+        const std::vector<Index> &targets() const { return to_; }
+        const std::vector<W> &weights() const { return weight_; }
+
+    private:
+        std::vector<std::size_t> offset_;
+        std::vector<Index> to_;
+        std::vector<W> weight_;
+    };
+}
@@ -1,21 +1,15 @@
+#pragma once
 #include <vector>
 #include <concepts>
-#include <format>
 #include <cassert>
+#include <cstddef>
+#include <bit>
+#include <array>
+#include <algorithm>
+#include "../concepts/algebra_concepts.hpp"
 
 namespace gcl
 {
-    template <typename T>
-    concept ModuleLike =
-        std::default_initializable<T> &&
-        std::copyable<T> &&
-        requires(T a, T b) {
-            { a + b } -> std::same_as<T>;
-            { a - b } -> std::same_as<T>;
-            { a += b } -> std::same_as<T &>;
-            { a -= b } -> std::same_as<T &>;
-        };
-
     template <typename T>
         requires ModuleLike<T>
     class FenwickTree
@@ -23,12 +17,19 @@ namespace gcl
     public:
         FenwickTree(std::size_t size) : n_vals_(size), data_(size + std::size_t{1}) {}
 
+        // O(n) で構築する（各節点の値をすぐ上の節点に1回だけ足し込む）
         template <class U>
             requires std::convertible_to<U, T>
         explicit FenwickTree(const std::vector<U> &vec) : FenwickTree(vec.size())
         {
             for (auto i = std::size_t{0}; i < n_vals_; i++)
-                add(i, static_cast<T>(vec[i]));
+                data_[i + 1] = static_cast<T>(vec[i]);
+            for (auto i = std::size_t{1}; i <= n_vals_; i++)
+            {
+                const auto j = i + (i & -i);
+                if (j <= n_vals_)
+                    data_[j] += data_[i];
+            }
         }
 
         // add value to idx-th element (0-indexed)
@@ -37,32 +38,57 @@ namespace gcl
         void add(std::size_t idx, U val)
         {
             assert(idx < n_vals_);
+            const auto v = static_cast<T>(val);
             for (auto i = std::size_t{idx + 1}; i <= n_vals_; i += i & -i)
-                data_[i] += static_cast<T>(val);
+                data_[i] += v;
         }
 
         // return idx-th element
-        T get(std::size_t idx)
+        // `data_[idx + 1]`は区間`(idx + 1 - lsb, idx + 1]`の和なので、そこから`(idx + 1 - lsb, idx]`の和を引く
+        T get(std::size_t idx) const
         {
             assert(idx < n_vals_);
-            return sum_prefix(idx + 1) - sum_prefix(idx);
+            const auto i = idx + 1;
+            const auto stop = i - (i & -i);
+            T val = data_[i];
+            for (auto j = idx; j > stop; j -= j & -j)
+                val -= data_[j];
+            return val;
         }
 
         // return sum [l, r)
-        T sum(std::size_t l, std::size_t r)
+        T sum(std::size_t l, std::size_t r) const
         {
             assert(l <= r && r <= n_vals_);
             return sum_prefix(r) - sum_prefix(l);
         }
 
+        // `sum(0, idx + 1) >= val`となる最小の`idx`を返す（存在しなければ`size()`）
+        // 全ての要素が`T{}`以上（prefix sum が単調非減少）である必要がある
+        std::size_t lower_bound(const T &val) const
+            requires std::totally_ordered<T>
+        {
+            std::size_t pos = 0;
+            T acc{};
+            for (auto step = std::bit_floor(n_vals_); step > 0; step >>= 1)
+            {
+                if (pos + step <= n_vals_ && acc + data_[pos + step] < val)
+                {
+                    pos += step;
+                    acc += data_[pos];
+                }
+            }
+            return pos;
+        }
+
         std::size_t size() const { return n_vals_; }
 
     private:
-        std::vector<T> data_;
         const std::size_t n_vals_;
+        std::vector<T> data_;
 
         // return sum [0, r)
-        inline T sum_prefix(std::size_t r)
+        inline T sum_prefix(std::size_t r) const
         {
             T sum{};
             for (auto i = std::size_t{r}; i > 0; i -= i & -i)
@@ -70,4 +96,314 @@ namespace gcl
             return sum;
         }
     };
-}
\ No newline at end of file
+
+    // 区間加算・区間和の Fenwick Tree
+    // 2本の`FenwickTree`を持ち、`sum(0, r) = r * B1(r) - B2(r)`として計算する
+    template <typename T>
+        requires ModuleLike<T>
+    class RangeAddFenwickTree
+    {
+    public:
+        RangeAddFenwickTree(std::size_t size) : coef_(size + 1), offset_(size + 1) {}
+
+        // O(n) で構築する
+        template <class U>
+            requires std::convertible_to<U, T>
+        explicit RangeAddFenwickTree(const std::vector<U> &vec) : coef_(vec.size() + 1), offset_(negated(vec)) {}
+
+        // 区間`[l, r)`の各要素に`val`を加算する
+        template <class U>
+            requires std::convertible_to<U, T>
+        void add(std::size_t l, std::size_t r, U val)
+        {
+            assert(l <= r && r <= size());
+            const auto v = static_cast<T>(val);
+            coef_.add(l, v);
+            coef_.add(r, T{} - v);
+            offset_.add(l, scale(v, l));
+            offset_.add(r, T{} - scale(v, r));
+        }
+
+        // idx-th element に`val`を加算する
+        template <class U>
+            requires std::convertible_to<U, T>
+        void add(std::size_t idx, U val)
+        {
+            add(idx, idx + 1, val);
+        }
+
+        // return sum [l, r)
+        T sum(std::size_t l, std::size_t r) const
+        {
+            assert(l <= r && r <= size());
+            return sum_prefix(r) - sum_prefix(l);
+        }
+
+        // return idx-th element
+        T get(std::size_t idx) const
+        {
+            assert(idx < size());
+            return sum(idx, idx + 1);
+        }
+
+        std::size_t size() const { return coef_.size() - 1; }
+
+    private:
+        // `coef_`の`i`番目までの和が`i`番目の要素への加算量、`offset_`は`sum(0, r)`の補正項
+        // 要素数より1つ多く持ち、`add(l, r, ...)`で`r == size()`の場合も扱えるようにしている
+        FenwickTree<T> coef_, offset_;
+
+        // `x`を`k`倍する。`T`同士の積が定義されていなければ倍々に足して求める
+        static T scale(const T &x, std::size_t k)
+        {
+            if constexpr (requires { { x * static_cast<T>(k) } -> std::convertible_to<T>; })
+                return static_cast<T>(x * static_cast<T>(k));
+            else
+            {
+                T result{}, base = x;
+                for (; k > 0; k >>= 1)
+                {
+                    if (k & 1)
+                        result += base;
+                    base += T(base);
+                }
+                return result;
+            }
+        }
+
+        template <class U>
+        static std::vector<T> negated(const std::vector<U> &vec)
+        {
+            std::vector<T> result(vec.size() + 1);
+            for (std::size_t i = 0; i < vec.size(); i++)
+                result[i] = T{} - static_cast<T>(vec[i]);
+            return result;
+        }
+
+        T sum_prefix(std::size_t r) const
+        {
+            return scale(coef_.sum(0, r), r) - offset_.sum(0, r);
+        }
+    };
+
+    // 2段構成の Fenwick Tree
+    // 要素を長さ`Block`のブロックに分け、ブロック内は累積和をそのまま連続した領域に持ち、
+    // ブロックの総和は別の`FenwickTree`で管理する。上位の木は要素数の`1 / Block`なのでキャッシュに載りやすい
+    // 区間和では下位の領域を1回読むだけで済み、一点加算はブロック内の連続した領域への加算（ベクトル化される）になる
+    template <typename T, std::size_t Block = 32>
+        requires ModuleLike<T> && (Block > 0)
+    class BlockedFenwickTree
+    {
+    public:
+        BlockedFenwickTree(std::size_t size) : n_vals_(size), inner_(n_blocks(size) * Block), outer_(n_blocks(size)) {}
+
+        // O(n) で構築する
+        template <class U>
+            requires std::convertible_to<U, T>
+        explicit BlockedFenwickTree(const std::vector<U> &vec) : n_vals_(vec.size()), inner_(n_blocks(vec.size()) * Block), outer_(block_sums(vec))
+        {
+            // 最後のブロックの`n`以降にも累積和を伸ばしておく（`lower_bound`で使う）
+            for (std::size_t i = 0; i < inner_.size(); i++)
+            {
+                if (i < n_vals_)
+                    inner_[i] = static_cast<T>(vec[i]);
+                if (i % Block != 0)
+                    inner_[i] += inner_[i - 1];
+            }
+        }
+
+        // add value to idx-th element (0-indexed)
+        template <class U>
+            requires std::convertible_to<U, T>
+        void add(std::size_t idx, U val)
+        {
+            assert(idx < n_vals_);
+            const auto v = static_cast<T>(val);
+            T *block = inner_.data() + idx / Block * Block;
+            for (auto i = idx % Block; i < Block; i++)
+                block[i] += v;
+            outer_.add(idx / Block, v);
+        }
+
+        // return idx-th element
+        T get(std::size_t idx) const
+        {
+            assert(idx < n_vals_);
+            return idx % Block == 0 ? inner_[idx] : inner_[idx] - inner_[idx - 1];
+        }
+
+        // return sum [l, r)
+        T sum(std::size_t l, std::size_t r) const
+        {
+            assert(l <= r && r <= n_vals_);
+            const auto lb = l / Block, rb = r / Block;
+            T sum = lb == rb ? T{} : outer_.sum(lb, rb);
+            if (r % Block != 0)
+                sum += inner_[r - 1];
+            if (l % Block != 0)
+                sum -= inner_[l - 1];
+            return sum;
+        }
+
+        // `sum(0, idx + 1) >= val`となる最小の`idx`を返す（存在しなければ`size()`）
+        // 全ての要素が`T{}`以上である必要がある
+        std::size_t lower_bound(const T &val) const
+            requires std::totally_ordered<T>
+        {
+            const auto b = outer_.lower_bound(val);
+            if (b == outer_.size())
+                return n_vals_;
+            // ブロック`b`の中で、累積和が残り`val - acc`に達する位置を探す
+            const T rest = val - outer_.sum(0, b);
+            const auto first = inner_.begin() + b * Block;
+            const auto it = std::partition_point(first, first + Block, [&](const T &x)
+                                                 { return x < rest; });
+            return std::min(b * Block + static_cast<std::size_t>(it - first), n_vals_);
+        }
+
+        std::size_t size() const { return n_vals_; }
+
+    private:
+        std::size_t n_vals_;
+        // ブロックごとの累積和（`inner_[i]`はブロックの先頭から`i`番目までの和）
+        std::vector<T> inner_;
+        FenwickTree<T> outer_;
+
+        static std::size_t n_blocks(std::size_t size) { return (size + Block - 1) / Block; }
+
+        template <class U>
+        static std::vector<T> block_sums(const std::vector<U> &vec)
+        {
+            std::vector<T> sums(n_blocks(vec.size()));
+            for (std::size_t i = 0; i < vec.size(); i++)
+                sums[i / Block] += static_cast<T>(vec[i]);
+            return sums;
+        }
+    };
+
+    // `Dim`次元の Fenwick Tree。全ての要素を1つの配列に行優先で置く
+    // 各次元について 0-indexed の Fenwick Tree（`i`番目は`[i & (i + 1), i]`の和）を重ねたものになっている
+    template <typename T, std::size_t Dim>
+        requires ModuleLike<T> && (Dim > 0)
+    class FenwickTreeND
+    {
+    public:
+        using index_type = std::array<std::size_t, Dim>;
+
+        explicit FenwickTreeND(const index_type &shape) : shape_(shape), data_(compute_strides())
+        {
+        }
+
+        // 行優先に並べた初期値`values`から O(要素数) で構築する
+        template <class U>
+            requires std::convertible_to<U, T>
+        FenwickTreeND(const index_type &shape, const std::vector<U> &values) : FenwickTreeND(shape)
+        {
+            assert(values.size() == data_.size());
+            for (std::size_t i = 0; i < data_.size(); i++)
+                data_[i] = static_cast<T>(values[i]);
+            // 次元ごとに、その次元に沿った各列へ1次元の線形構築を行う
+            for (std::size_t d = 0; d < Dim; d++)
+            {
+                for (std::size_t flat = 0; flat < data_.size(); flat++)
+                {
+                    const auto i = flat / stride_[d] % shape_[d];
+                    const auto j = i | (i + 1);
+                    if (j < shape_[d])
+                        data_[flat + (j - i) * stride_[d]] += data_[flat];
+                }
+            }
+        }
+
+        // `idx`の要素に`val`を加算する
+        template <class U>
+            requires std::convertible_to<U, T>
+        void add(const index_type &idx, U val)
+        {
+            for (std::size_t d = 0; d < Dim; d++)
+                assert(idx[d] < shape_[d]);
+            add_rec<0>(0, idx, static_cast<T>(val));
+        }
+
+        // 直方体`[lo[0], hi[0]) × ... × [lo[Dim-1], hi[Dim-1])`の和を返す（包除原理で 2^Dim 回の prefix sum）
+        T sum(const index_type &lo, const index_type &hi) const
+        {
+            T plus{}, minus{};
+            for (std::size_t mask = 0; mask < (std::size_t{1} << Dim); mask++)
+            {
+                index_type corner;
+                for (std::size_t d = 0; d < Dim; d++)
+                {
+                    assert(lo[d] <= hi[d] && hi[d] <= shape_[d]);
+                    corner[d] = (mask >> d & 1) ? lo[d] : hi[d];
+                }
+                if (std::popcount(mask) % 2 == 0)
+                    plus += sum_prefix(corner);
+                else
+                    minus += sum_prefix(corner);
+            }
+            return plus - minus;
+        }
+
+        // 原点を頂点とする直方体`[0, r[0]) × ... × [0, r[Dim-1])`の和を返す
+        T sum_prefix(const index_type &r) const
+        {
+            return prefix_rec<0>(0, r);
+        }
+
+        // `idx`の要素を返す
+        T get(const index_type &idx) const
+        {
+            index_type hi;
+            for (std::size_t d = 0; d < Dim; d++)
+                hi[d] = idx[d] + 1;
+            return sum(idx, hi);
+        }
+
+        const index_type &shape() const { return shape_; }
+
+        // 全要素数
+        std::size_t size() const { return data_.size(); }
+
+    private:
+        index_type shape_, stride_;
+        std::vector<T> data_;
+
+        std::size_t compute_strides()
+        {
+            std::size_t total = 1;
+            for (std::size_t d = Dim; d-- > 0;)
+            {
+                stride_[d] = total;
+                total *= shape_[d];
+            }
+            return total;
+        }
+
+        template <std::size_t D>
+        void add_rec(std::size_t offset, const index_type &idx, const T &val)
+        {
+            for (auto i = idx[D]; i < shape_[D]; i |= i + 1)
+            {
+                if constexpr (D + 1 == Dim)
+                    data_[offset + i] += val;
+                else
+                    add_rec<D + 1>(offset + i * stride_[D], idx, val);
+            }
+        }
+
+        template <std::size_t D>
+        T prefix_rec(std::size_t offset, const index_type &r) const
+        {
+            T sum{};
+            for (auto i = r[D]; i > 0; i &= i - 1)
+            {
+                if constexpr (D + 1 == Dim)
+                    sum += data_[offset + i - 1];
+                else
+                    sum += prefix_rec<D + 1>(offset + (i - 1) * stride_[D], r);
+            }
+            return sum;
+        }
+    };
+}
@@ -0,0 +1,175 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <limits>
+#include <utility>
+
+namespace gcl
+{
+    // 要素番号`0..N-1`に鍵を対応させる d 分木ヒープ（最小ヒープ）
+    // 各要素番号はヒープ中に高々1つしか存在せず、`decrease_key`で鍵を小さく出来る
+    // `Arity`が4や8のとき、兄弟の鍵が1本のキャッシュラインに収まりやすい
+    template <std::totally_ordered Key, std::size_t Arity = 4>
+        requires(Arity >= 2)
+    class IndexedDaryHeap
+    {
+    public:
+        /*
+            @brief 要素番号`0..n_ids-1`を扱える空のヒープを構築する
+        */
+        explicit IndexedDaryHeap(std::size_t n_ids) : pos_(n_ids, NONE) {}
+
+        [[nodiscard]] bool empty() const { return keys_.empty(); }
+        [[nodiscard]] std::size_t size() const { return keys_.size(); }
+
+        // 扱える要素番号の上限
+        [[nodiscard]] std::size_t capacity() const { return pos_.size(); }
+
+        // `id`がヒープ中に存在するか返す
+        [[nodiscard]] bool contains(std::size_t id) const
+        {
+            assert(id < pos_.size());
+            return pos_[id] != NONE;
+        }
+
+        // `id`の鍵を返す（`id`はヒープ中に存在する必要がある）
+        [[nodiscard]] const Key &key(std::size_t id) const
+        {
+            assert(contains(id));
+            return keys_[pos_[id]];
+        }
+
+        // 鍵が最小の要素番号を返す
+        [[nodiscard]] std::size_t top() const
+        {
+            assert(!empty());
+            return ids_[0];
+        }
+
+        // 最小の鍵を返す
+        [[nodiscard]] const Key &top_key() const
+        {
+            assert(!empty());
+            return keys_[0];
+        }
+
+        // `id`を鍵`key`で追加する（`id`はヒープ中に存在してはならない）
+        void push(std::size_t id, Key key)
+        {
+            assert(!contains(id));
+            keys_.push_back(std::move(key));
+            ids_.push_back(id);
+            pos_[id] = keys_.size() - 1;
+            sift_up(keys_.size() - 1);
+        }
+
+        // `id`の鍵を`key`に減少させる（`key`は現在の鍵以下である必要がある）
+        void decrease_key(std::size_t id, Key key)
+        {
+            assert(contains(id) && !(keys_[pos_[id]] < key));
+            keys_[pos_[id]] = std::move(key);
+            sift_up(pos_[id]);
+        }
+
+        // `id`が存在しなければ追加し、存在すれば鍵を`key`との最小値に更新する
+        // ヒープが変化した場合`true`を返す
+        bool push_or_decrease(std::size_t id, Key key)
+        {
+            if (!contains(id))
+            {
+                push(id, std::move(key));
+                return true;
+            }
+            if (!(key < keys_[pos_[id]]))
+                return false;
+            decrease_key(id, std::move(key));
+            return true;
+        }
+
+        // 鍵が最小の組`{key, id}`を取り出す
+        std::pair<Key, std::size_t> pop()
+        {
+            assert(!empty());
+            std::pair<Key, std::size_t> result{std::move(keys_[0]), ids_[0]};
+            pos_[result.second] = NONE;
+            if (keys_.size() > 1)
+            {
+                keys_[0] = std::move(keys_.back());
+                ids_[0] = ids_.back();
+                pos_[ids_[0]] = 0;
+            }
+            keys_.pop_back();
+            ids_.pop_back();
+            if (!keys_.empty())
+                sift_down(0);
+            return result;
+        }
+
+        // 全要素を削除する。計算量はヒープ中の要素数に比例する
+        void clear()
+        {
+            for (auto id : ids_)
+                pos_[id] = NONE;
+            keys_.clear();
+            ids_.clear();
+        }
+
+    private:
+        static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+        // ヒープ順に並べた鍵と要素番号、および要素番号からヒープ上の位置への対応
+        std::vector<Key> keys_;
+        std::vector<std::size_t> ids_;
+        std::vector<std::size_t> pos_;
+
+        void move_to(std::size_t i, Key &&key, std::size_t id)
+        {
+            keys_[i] = std::move(key);
+            ids_[i] = id;
+            pos_[id] = i;
+        }
+
+        void sift_up(std::size_t i)
+        {
+            Key key = std::move(keys_[i]);
+            const auto id = ids_[i];
+            while (i > 0)
+            {
+                const auto parent = (i - 1) / Arity;
+                if (!(key < keys_[parent]))
+                    break;
+                move_to(i, std::move(keys_[parent]), ids_[parent]);
+                i = parent;
+            }
+            move_to(i, std::move(key), id);
+        }
+
+        void sift_down(std::size_t i)
+        {
+            Key key = std::move(keys_[i]);
+            const auto id = ids_[i];
+            const auto n = keys_.size();
+            while (true)
+            {
+                const auto first = i * Arity + 1;
+                if (first >= n)
+                    break;
+                const auto last = std::min(first + Arity, n);
+                auto best = first;
+                for (auto c = first + 1; c < last; c++)
+                {
+                    if (keys_[c] < keys_[best])
+                        best = c;
+                }
+                if (!(keys_[best] < key))
+                    break;
+                move_to(i, std::move(keys_[best]), ids_[best]);
+                i = best;
+            }
+            move_to(i, std::move(key), id);
+        }
+    };
+}
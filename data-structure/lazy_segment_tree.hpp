@@ -0,0 +1,223 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cassert>
+#include <concepts>
+#include <algorithm>
+#include <bit>
+#include "../concepts/algebra_concepts.hpp"
+
+namespace gcl
+{
+    // 非再帰の遅延評価セグメント木
+    // 葉の数を2冪`size_`に切り上げ、節点`i`の子を`2i`, `2i + 1`とする（葉は`size_ + idx`）
+    // `lazy_[i]`は節点`i`の子にまだ伝えていない作用（`data_[i]`には作用済み）
+    template <Monoid M, typename A>
+        requires MonoidAction<A, M>
+    class LazySegTree
+    {
+    public:
+        using value_type = typename M::value_type;
+        using action_type = typename A::value_type;
+
+        explicit LazySegTree(std::size_t size) : LazySegTree(std::vector<value_type>(size, M::identity())) {}
+
+        // O(n) で構築する
+        explicit LazySegTree(const std::vector<value_type> &vec)
+            : n_vals_(vec.size()), size_(std::bit_ceil(std::max<std::size_t>(vec.size(), 1))),
+              log_(static_cast<std::size_t>(std::countr_zero(size_))),
+              data_(2 * size_, M::identity()), lazy_(size_, A::identity())
+        {
+            std::copy(vec.begin(), vec.end(), data_.begin() + static_cast<std::ptrdiff_t>(size_));
+            for (auto i = size_ - 1; i >= 1; i--)
+                update(i);
+        }
+
+        // idx-th element を`val`にする
+        void set(std::size_t idx, const value_type &val)
+        {
+            assert(idx < n_vals_);
+            idx += size_;
+            push_path(idx);
+            data_[idx] = val;
+            for (std::size_t i = 1; i <= log_; i++)
+                update(idx >> i);
+        }
+
+        // return idx-th element
+        [[nodiscard]] value_type get(std::size_t idx)
+        {
+            assert(idx < n_vals_);
+            idx += size_;
+            push_path(idx);
+            return data_[idx];
+        }
+
+        // return op(a[l], ..., a[r - 1])
+        [[nodiscard]] value_type prod(std::size_t l, std::size_t r)
+        {
+            assert(l <= r && r <= n_vals_);
+            if (l == r)
+                return M::identity();
+            l += size_;
+            r += size_;
+            push_bounds(l, r);
+            value_type left = M::identity(), right = M::identity();
+            for (; l < r; l >>= 1, r >>= 1)
+            {
+                if (l & 1)
+                    left = M::op(left, data_[l++]);
+                if (r & 1)
+                    right = M::op(data_[--r], right);
+            }
+            return M::op(left, right);
+        }
+
+        [[nodiscard]] const value_type &all_prod() const { return data_[1]; }
+
+        // idx-th element に`f`を作用させる
+        void apply(std::size_t idx, const action_type &f)
+        {
+            assert(idx < n_vals_);
+            idx += size_;
+            push_path(idx);
+            data_[idx] = A::act(f, data_[idx]);
+            for (std::size_t i = 1; i <= log_; i++)
+                update(idx >> i);
+        }
+
+        // 区間`[l, r)`の各要素に`f`を作用させる
+        void apply(std::size_t l, std::size_t r, const action_type &f)
+        {
+            assert(l <= r && r <= n_vals_);
+            if (l == r)
+                return;
+            l += size_;
+            r += size_;
+            push_bounds(l, r);
+            for (auto a = l, b = r; a < b; a >>= 1, b >>= 1)
+            {
+                if (a & 1)
+                    apply_node(a++, f);
+                if (b & 1)
+                    apply_node(--b, f);
+            }
+            // 区間の端を含む節点だけを下から更新し直す
+            for (std::size_t i = 1; i <= log_; i++)
+            {
+                if (((l >> i) << i) != l)
+                    update(l >> i);
+                if (((r >> i) << i) != r)
+                    update((r - 1) >> i);
+            }
+        }
+
+        // `pred(prod(l, r))`が真となる最大の`r`を返す
+        // `pred`は単調（`r`を伸ばすと真から偽にしか変わらない）で、`pred(M::identity())`は真である必要がある
+        template <class Pred>
+        [[nodiscard]] std::size_t max_right(std::size_t l, Pred pred)
+        {
+            assert(l <= n_vals_);
+            assert(pred(M::identity()));
+            if (l == n_vals_)
+                return n_vals_;
+            l += size_;
+            push_path(l);
+            value_type acc = M::identity();
+            do
+            {
+                while (l % 2 == 0)
+                    l >>= 1;
+                if (!pred(M::op(acc, data_[l])))
+                {
+                    // 条件を満たさなくなる葉まで降りる
+                    while (l < size_)
+                    {
+                        push(l);
+                        l = 2 * l;
+                        if (pred(M::op(acc, data_[l])))
+                            acc = M::op(acc, data_[l++]);
+                    }
+                    return l - size_;
+                }
+                acc = M::op(acc, data_[l++]);
+            } while ((l & -l) != l);
+            return n_vals_;
+        }
+
+        // `pred(prod(l, r))`が真となる最小の`l`を返す
+        // `pred`は単調（`l`を縮めると真から偽にしか変わらない）で、`pred(M::identity())`は真である必要がある
+        template <class Pred>
+        [[nodiscard]] std::size_t min_left(std::size_t r, Pred pred)
+        {
+            assert(r <= n_vals_);
+            assert(pred(M::identity()));
+            if (r == 0)
+                return 0;
+            r += size_;
+            push_path(r - 1);
+            value_type acc = M::identity();
+            do
+            {
+                r--;
+                while (r > 1 && r % 2 == 1)
+                    r >>= 1;
+                if (!pred(M::op(data_[r], acc)))
+                {
+                    while (r < size_)
+                    {
+                        push(r);
+                        r = 2 * r + 1;
+                        if (pred(M::op(data_[r], acc)))
+                            acc = M::op(data_[r--], acc);
+                    }
+                    return r + 1 - size_;
+                }
+                acc = M::op(data_[r], acc);
+            } while ((r & -r) != r);
+            return 0;
+        }
+
+        std::size_t size() const { return n_vals_; }
+
+    private:
+        std::size_t n_vals_, size_, log_;
+        std::vector<value_type> data_;
+        std::vector<action_type> lazy_;
+
+        void update(std::size_t i) { data_[i] = M::op(data_[2 * i], data_[2 * i + 1]); }
+
+        void apply_node(std::size_t i, const action_type &f)
+        {
+            data_[i] = A::act(f, data_[i]);
+            if (i < size_)
+                lazy_[i] = A::op(f, lazy_[i]);
+        }
+
+        void push(std::size_t i)
+        {
+            apply_node(2 * i, lazy_[i]);
+            apply_node(2 * i + 1, lazy_[i]);
+            lazy_[i] = A::identity();
+        }
+
+        // 葉`leaf`の祖先の作用を上から順に伝える
+        void push_path(std::size_t leaf)
+        {
+            for (auto i = log_; i >= 1; i--)
+                push(leaf >> i);
+        }
+
+        // 葉の区間`[l, r)`の端を含む節点について、祖先の作用を上から順に伝える
+        void push_bounds(std::size_t l, std::size_t r)
+        {
+            for (auto i = log_; i >= 1; i--)
+            {
+                if (((l >> i) << i) != l)
+                    push(l >> i);
+                if (((r >> i) << i) != r)
+                    push((r - 1) >> i);
+            }
+        }
+    };
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cassert>
+#include <concepts>
+#include <bit>
+#include <algorithm>
+#include "../concepts/algebra_concepts.hpp"
+
+namespace gcl
+{
+    // 非再帰のセグメント木
+    // 葉の数を2冪`size_`に切り上げ、節点`i`の子を`2i`, `2i + 1`とする（葉は`size_ + idx`）
+    template <Monoid M>
+    class SegTree
+    {
+    public:
+        using value_type = typename M::value_type;
+
+        explicit SegTree(std::size_t size) : SegTree(std::vector<value_type>(size, M::identity())) {}
+
+        // O(n) で構築する
+        explicit SegTree(const std::vector<value_type> &vec)
+            : n_vals_(vec.size()), size_(std::bit_ceil(std::max<std::size_t>(vec.size(), 1))), data_(2 * size_, M::identity())
+        {
+            std::copy(vec.begin(), vec.end(), data_.begin() + static_cast<std::ptrdiff_t>(size_));
+            for (auto i = size_ - 1; i >= 1; i--)
+                update(i);
+        }
+
+        // idx-th element を`val`にする
+        void set(std::size_t idx, const value_type &val)
+        {
+            assert(idx < n_vals_);
+            idx += size_;
+            data_[idx] = val;
+            for (idx >>= 1; idx >= 1; idx >>= 1)
+                update(idx);
+        }
+
+        // return idx-th element
+        [[nodiscard]] const value_type &get(std::size_t idx) const
+        {
+            assert(idx < n_vals_);
+            return data_[idx + size_];
+        }
+
+        // return op(a[l], ..., a[r - 1])
+        [[nodiscard]] value_type prod(std::size_t l, std::size_t r) const
+        {
+            assert(l <= r && r <= n_vals_);
+            // 左右から葉を登り、左側の結果と右側の結果を別々に溜める（非可換でも良い）
+            value_type left = M::identity(), right = M::identity();
+            for (l += size_, r += size_; l < r; l >>= 1, r >>= 1)
+            {
+                if (l & 1)
+                    left = M::op(left, data_[l++]);
+                if (r & 1)
+                    right = M::op(data_[--r], right);
+            }
+            return M::op(left, right);
+        }
+
+        [[nodiscard]] const value_type &all_prod() const { return data_[1]; }
+
+        // `pred(prod(l, r))`が真となる最大の`r`を返す
+        // `pred`は単調（`r`を伸ばすと真から偽にしか変わらない）で、`pred(M::identity())`は真である必要がある
+        template <class Pred>
+        [[nodiscard]] std::size_t max_right(std::size_t l, Pred pred) const
+        {
+            assert(l <= n_vals_);
+            assert(pred(M::identity()));
+            if (l == n_vals_)
+                return n_vals_;
+            l += size_;
+            value_type acc = M::identity();
+            do
+            {
+                while (l % 2 == 0)
+                    l >>= 1;
+                if (!pred(M::op(acc, data_[l])))
+                {
+                    // 条件を満たさなくなる葉まで降りる
+                    while (l < size_)
+                    {
+                        l = 2 * l;
+                        if (pred(M::op(acc, data_[l])))
+                            acc = M::op(acc, data_[l++]);
+                    }
+                    return l - size_;
+                }
+                acc = M::op(acc, data_[l++]);
+            } while ((l & -l) != l);
+            return n_vals_;
+        }
+
+        // `pred(prod(l, r))`が真となる最小の`l`を返す
+        // `pred`は単調（`l`を縮めると真から偽にしか変わらない）で、`pred(M::identity())`は真である必要がある
+        template <class Pred>
+        [[nodiscard]] std::size_t min_left(std::size_t r, Pred pred) const
+        {
+            assert(r <= n_vals_);
+            assert(pred(M::identity()));
+            if (r == 0)
+                return 0;
+            r += size_;
+            value_type acc = M::identity();
+            do
+            {
+                r--;
+                while (r > 1 && r % 2 == 1)
+                    r >>= 1;
+                if (!pred(M::op(data_[r], acc)))
+                {
+                    while (r < size_)
+                    {
+                        r = 2 * r + 1;
+                        if (pred(M::op(data_[r], acc)))
+                            acc = M::op(data_[r--], acc);
+                    }
+                    return r + 1 - size_;
+                }
+                acc = M::op(data_[r], acc);
+            } while ((r & -r) != r);
+            return 0;
+        }
+
+        std::size_t size() const { return n_vals_; }
+
+    private:
+        std::size_t n_vals_, size_;
+        std::vector<value_type> data_;
+
+        void update(std::size_t i) { data_[i] = M::op(data_[2 * i], data_[2 * i + 1]); }
+    };
+}
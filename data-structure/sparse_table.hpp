@@ -0,0 +1,67 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <bit>
+
+namespace gcl
+{
+    // 静的な列の区間最小値（`Compare`で最小）を O(1) で返す Sparse Table
+    // 段`k`の`i`番目に区間`[i, i + 2^k)`の最小値を持つ。全ての段を1本の配列に並べる
+    template <std::copyable T, class Compare = std::less<>>
+    class SparseTable
+    {
+    public:
+        SparseTable() = default;
+
+        // O(n log n) で構築する
+        explicit SparseTable(std::vector<T> vec, Compare comp = {}) : n_vals_(vec.size()), comp_(comp)
+        {
+            const auto levels = n_vals_ == 0 ? std::size_t{1} : static_cast<std::size_t>(std::bit_width(n_vals_));
+            offset_.assign(levels + 1, 0);
+            for (std::size_t k = 0; k < levels; k++)
+                offset_[k + 1] = offset_[k] + n_vals_ - (std::size_t{1} << k) + 1;
+            // `T`にデフォルト構築を要求しないよう、`resize`ではなく末尾に追加して各段を作る
+            data_ = std::move(vec);
+            data_.reserve(offset_[levels]);
+            for (std::size_t k = 1; k < levels; k++)
+            {
+                const auto half = std::size_t{1} << (k - 1);
+                const auto prev = offset_[k - 1];
+                const auto len = offset_[k + 1] - offset_[k];
+                for (std::size_t i = 0; i < len; i++)
+                {
+                    const T &a = data_[prev + i], &b = data_[prev + i + half];
+                    data_.push_back(comp_(b, a) ? b : a);
+                }
+            }
+        }
+
+        // 区間`[l, r)`の最小値を返す（`l < r`である必要がある）
+        [[nodiscard]] const T &prod(std::size_t l, std::size_t r) const
+        {
+            assert(l < r && r <= n_vals_);
+            const auto k = static_cast<std::size_t>(std::bit_width(r - l)) - 1;
+            const T *level = data_.data() + offset_[k];
+            const T &a = level[l], &b = level[r - (std::size_t{1} << k)];
+            return comp_(b, a) ? b : a;
+        }
+
+        // return idx-th element
+        [[nodiscard]] const T &get(std::size_t idx) const
+        {
+            assert(idx < n_vals_);
+            return data_[idx];
+        }
+
+        std::size_t size() const { return n_vals_; }
+
+    private:
+        std::size_t n_vals_ = 0;
+        [[no_unique_address]] Compare comp_{};
+        std::vector<std::size_t> offset_;
+        std::vector<T> data_;
+    };
+}
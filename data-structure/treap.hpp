@@ -0,0 +1,837 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <utility>
+#include "../concepts/algebra_concepts.hpp"
+
+namespace gcl
+{
+    // 節点を1本の配列（アリーナ）に持ち、32bit の番号で参照する Treap
+    // 1つのアリーナに複数の木を持てる。木は根の番号（`node_type`）で表し、0 は空の木を表す
+    // 列として扱う（暗黙のキー）操作と、値の順序で並べる操作（順序付き集合）を提供する
+    // `A`を与えると区間への遅延作用が使える。各節点は逆順の集約値も持つため、`M::op`が非可換でも`reverse`できる
+    template <Monoid M, typename A = NoAction<M>>
+        requires MonoidAction<A, M>
+    class Treap
+    {
+    public:
+        using value_type = typename M::value_type;
+        using action_type = typename A::value_type;
+        using node_type = std::uint32_t;
+
+        static constexpr node_type NIL = 0;
+
+        explicit Treap(std::size_t reserve_nodes = 0, std::uint32_t seed = 2463534242u) : rng_(seed == 0 ? 1 : seed)
+        {
+            nodes_.reserve(reserve_nodes + 1);
+            // 番兵（空の木）。サイズ 0、集約値は単位元
+            nodes_.push_back(Node{M::identity(), M::identity(), M::identity(), A::identity(), NIL, NIL, 0, 0, false, false});
+        }
+
+        // `n`個の節点を確保しておく
+        void reserve(std::size_t n) { nodes_.reserve(n + 1); }
+
+        // 使用中の節点数
+        [[nodiscard]] std::size_t node_count() const { return nodes_.size() - 1 - free_.size(); }
+
+        // 値`val`だけを持つ木を作る
+        node_type make(const value_type &val)
+        {
+            node_type t;
+            if (!free_.empty())
+            {
+                t = free_.back();
+                free_.pop_back();
+                nodes_[t] = Node{val, val, val, A::identity(), NIL, NIL, next_priority(), 1, false, false};
+            }
+            else
+            {
+                assert(nodes_.size() < std::numeric_limits<node_type>::max());
+                t = static_cast<node_type>(nodes_.size());
+                nodes_.push_back(Node{val, val, val, A::identity(), NIL, NIL, next_priority(), 1, false, false});
+            }
+            return t;
+        }
+
+        // 範囲`range`の値をこの順に並べた木を O(n) で作る（順序付き集合として使う場合は`range`がソート済みである必要がある）
+        // 優先度の大きい節点を根とする Cartesian tree をスタックで構築する
+        template <std::ranges::input_range R>
+            requires std::convertible_to<std::ranges::range_reference_t<R>, value_type>
+        node_type build(R &&range)
+        {
+            std::vector<node_type> stack;
+            for (auto &&val : range)
+            {
+                const auto t = make(static_cast<value_type>(val));
+                node_type last = NIL;
+                while (!stack.empty() && nodes_[stack.back()].priority < nodes_[t].priority)
+                {
+                    last = stack.back();
+                    stack.pop_back();
+                    pull(last);
+                }
+                nodes_[t].left = last;
+                if (!stack.empty())
+                    nodes_[stack.back()].right = t;
+                stack.push_back(t);
+            }
+            if (stack.empty())
+                return NIL;
+            while (stack.size() > 1)
+            {
+                pull(stack.back());
+                stack.pop_back();
+            }
+            pull(stack[0]);
+            return stack[0];
+        }
+
+        // 木`t`の要素数
+        [[nodiscard]] std::size_t size(node_type t) const { return nodes_[t].size; }
+
+        // 木`t`の全要素の集約値
+        [[nodiscard]] value_type prod(node_type t) const { return nodes_[t].sum; }
+
+        // 木`l`の後ろに木`r`を連結した木を返す
+        node_type merge(node_type l, node_type r)
+        {
+            if (l == NIL)
+                return r;
+            if (r == NIL)
+                return l;
+            if (nodes_[l].priority > nodes_[r].priority)
+            {
+                push(l);
+                nodes_[l].right = merge(nodes_[l].right, r);
+                pull(l);
+                return l;
+            }
+            push(r);
+            nodes_[r].left = merge(l, nodes_[r].left);
+            pull(r);
+            return r;
+        }
+
+        // 木`t`を先頭`k`要素とそれ以外に分割する
+        std::pair<node_type, node_type> split(node_type t, std::size_t k)
+        {
+            if (t == NIL)
+                return {NIL, NIL};
+            push(t);
+            const auto left_size = nodes_[nodes_[t].left].size;
+            if (k <= left_size)
+            {
+                const auto [a, b] = split(nodes_[t].left, k);
+                nodes_[t].left = b;
+                pull(t);
+                return {a, t};
+            }
+            const auto [a, b] = split(nodes_[t].right, k - left_size - 1);
+            nodes_[t].right = a;
+            pull(t);
+            return {t, b};
+        }
+
+        // `pos`番目の前に`val`を挿入する
+        void insert(node_type &root, std::size_t pos, const value_type &val)
+        {
+            assert(pos <= size(root));
+            const auto [a, b] = split(root, pos);
+            root = merge(merge(a, make(val)), b);
+        }
+
+        // `pos`番目の要素を削除し、その値を返す
+        value_type erase(node_type &root, std::size_t pos)
+        {
+            assert(pos < size(root));
+            const auto [a, bc] = split(root, pos);
+            const auto [b, c] = split(bc, 1);
+            const auto val = nodes_[b].value;
+            free_.push_back(b);
+            root = merge(a, c);
+            return val;
+        }
+
+        // `pos`番目の要素を返す
+        value_type get(node_type root, std::size_t pos)
+        {
+            assert(pos < size(root));
+            auto t = root;
+            while (true)
+            {
+                push(t);
+                const auto left_size = nodes_[nodes_[t].left].size;
+                if (pos == left_size)
+                    return nodes_[t].value;
+                if (pos < left_size)
+                    t = nodes_[t].left;
+                else
+                {
+                    pos -= left_size + 1;
+                    t = nodes_[t].right;
+                }
+            }
+        }
+
+        // `pos`番目の要素を`val`にする
+        void set(node_type &root, std::size_t pos, const value_type &val)
+        {
+            assert(pos < size(root));
+            const auto [a, bc] = split(root, pos);
+            const auto [b, c] = split(bc, 1);
+            nodes_[b].value = nodes_[b].sum = nodes_[b].rsum = val;
+            root = merge(merge(a, b), c);
+        }
+
+        // 区間`[l, r)`の集約値
+        value_type prod(node_type &root, std::size_t l, std::size_t r)
+        {
+            assert(l <= r && r <= size(root));
+            const auto [a, bc] = split(root, l);
+            const auto [b, c] = split(bc, r - l);
+            const auto val = nodes_[b].sum;
+            root = merge(merge(a, b), c);
+            return val;
+        }
+
+        // 区間`[l, r)`の各要素に`f`を作用させる
+        void apply(node_type &root, std::size_t l, std::size_t r, const action_type &f)
+        {
+            assert(l <= r && r <= size(root));
+            const auto [a, bc] = split(root, l);
+            const auto [b, c] = split(bc, r - l);
+            apply_node(b, f);
+            root = merge(merge(a, b), c);
+        }
+
+        // 区間`[l, r)`を反転する
+        void reverse(node_type &root, std::size_t l, std::size_t r)
+        {
+            assert(l <= r && r <= size(root));
+            const auto [a, bc] = split(root, l);
+            const auto [b, c] = split(bc, r - l);
+            if (b != NIL)
+                toggle_reverse(b);
+            root = merge(merge(a, b), c);
+        }
+
+        // 木`t`を値`val`より小さい要素とそれ以外（`val`以上）に分割する
+        template <class Compare = std::less<>>
+        std::pair<node_type, node_type> split_lower(node_type t, const value_type &val, Compare comp = {})
+        {
+            return split_by(t, [&](const value_type &x)
+                            { return comp(x, val); });
+        }
+
+        // 木`t`を値`val`以下の要素とそれ以外（`val`より大きい）に分割する
+        template <class Compare = std::less<>>
+        std::pair<node_type, node_type> split_upper(node_type t, const value_type &val, Compare comp = {})
+        {
+            return split_by(t, [&](const value_type &x)
+                            { return !comp(val, x); });
+        }
+
+        // `val`より小さい要素の個数
+        template <class Compare = std::less<>>
+        std::size_t lower_bound(node_type root, const value_type &val, Compare comp = {})
+        {
+            return count_by(root, [&](const value_type &x)
+                            { return comp(x, val); });
+        }
+
+        // `val`以下の要素の個数
+        template <class Compare = std::less<>>
+        std::size_t upper_bound(node_type root, const value_type &val, Compare comp = {})
+        {
+            return count_by(root, [&](const value_type &x)
+                            { return !comp(val, x); });
+        }
+
+        // 順序を保つ位置に`val`を挿入する（等しい要素があればその後ろ）
+        template <class Compare = std::less<>>
+        void insert_sorted(node_type &root, const value_type &val, Compare comp = {})
+        {
+            const auto [a, b] = split_upper(root, val, comp);
+            root = merge(merge(a, make(val)), b);
+        }
+
+        // `val`と等しい要素を1つ削除する。削除したか返す
+        template <class Compare = std::less<>>
+        bool erase_value(node_type &root, const value_type &val, Compare comp = {})
+        {
+            const auto [a, bc] = split_lower(root, val, comp);
+            const auto [b, c] = split(bc, 1);
+            if (b != NIL && !comp(val, nodes_[b].value))
+            {
+                free_.push_back(b);
+                root = merge(a, c);
+                return true;
+            }
+            root = merge(a, merge(b, c));
+            return false;
+        }
+
+        // 木`t`の要素を順に並べて返す
+        std::vector<value_type> to_vector(node_type t)
+        {
+            std::vector<value_type> result;
+            result.reserve(size(t));
+            std::vector<node_type> stack;
+            while (t != NIL || !stack.empty())
+            {
+                while (t != NIL)
+                {
+                    push(t);
+                    stack.push_back(t);
+                    t = nodes_[t].left;
+                }
+                t = stack.back();
+                stack.pop_back();
+                result.push_back(nodes_[t].value);
+                t = nodes_[t].right;
+            }
+            return result;
+        }
+
+        // 木`t`の全節点を解放し、以降の`make`で再利用する
+        void release(node_type t)
+        {
+            if (t == NIL)
+                return;
+            std::vector<node_type> stack{t};
+            while (!stack.empty())
+            {
+                const auto u = stack.back();
+                stack.pop_back();
+                free_.push_back(u);
+                if (nodes_[u].left != NIL)
+                    stack.push_back(nodes_[u].left);
+                if (nodes_[u].right != NIL)
+                    stack.push_back(nodes_[u].right);
+            }
+        }
+
+    private:
+        static constexpr bool HAS_ACTION = !std::same_as<A, NoAction<M>>;
+
+        struct Node
+        {
+            // `rsum`は部分木を逆順に並べたときの集約値
+            value_type value, sum, rsum;
+            [[no_unique_address]] action_type lazy;
+            node_type left, right;
+            std::uint32_t priority, size;
+            // `lazy`が恒等写像でない / 子を入れ替える必要がある
+            bool pending, reversed;
+        };
+
+        std::vector<Node> nodes_;
+        std::vector<node_type> free_;
+        std::uint32_t rng_;
+
+        std::uint32_t next_priority()
+        {
+            // xorshift32
+            rng_ ^= rng_ << 13;
+            rng_ ^= rng_ >> 17;
+            rng_ ^= rng_ << 5;
+            return rng_;
+        }
+
+        void pull(node_type t)
+        {
+            auto &node = nodes_[t];
+            const auto &l = nodes_[node.left];
+            const auto &r = nodes_[node.right];
+            node.size = l.size + r.size + 1;
+            node.sum = M::op(M::op(l.sum, node.value), r.sum);
+            node.rsum = M::op(M::op(r.rsum, node.value), l.rsum);
+        }
+
+        // 部分木`t`を反転する。`t`の集約値はすぐに入れ替え、子の入れ替えは`push`まで遅らせる
+        void toggle_reverse(node_type t)
+        {
+            auto &node = nodes_[t];
+            std::swap(node.sum, node.rsum);
+            node.reversed ^= true;
+        }
+
+        void apply_node(node_type t, const action_type &f)
+        {
+            if constexpr (HAS_ACTION)
+            {
+                if (t == NIL)
+                    return;
+                auto &node = nodes_[t];
+                node.value = A::act(f, node.value);
+                node.sum = A::act(f, node.sum);
+                node.rsum = A::act(f, node.rsum);
+                node.lazy = node.pending ? A::op(f, node.lazy) : f;
+                node.pending = true;
+            }
+        }
+
+        // 節点`t`に溜まっている作用・反転を子に伝える
+        void push(node_type t)
+        {
+            auto &node = nodes_[t];
+            if (node.reversed)
+            {
+                std::swap(node.left, node.right);
+                if (node.left != NIL)
+                    toggle_reverse(node.left);
+                if (node.right != NIL)
+                    toggle_reverse(node.right);
+                node.reversed = false;
+            }
+            if constexpr (HAS_ACTION)
+            {
+                if (node.pending)
+                {
+                    const auto f = node.lazy;
+                    node.pending = false;
+                    node.lazy = A::identity();
+                    apply_node(node.left, f);
+                    apply_node(node.right, f);
+                }
+            }
+        }
+
+        // 先頭から`pred`を満たす要素が続く部分とそれ以外に分割する（`pred`は単調である必要がある）
+        template <class Pred>
+        std::pair<node_type, node_type> split_by(node_type t, const Pred &pred)
+        {
+            if (t == NIL)
+                return {NIL, NIL};
+            push(t);
+            if (pred(nodes_[t].value))
+            {
+                const auto [a, b] = split_by(nodes_[t].right, pred);
+                nodes_[t].right = a;
+                pull(t);
+                return {t, b};
+            }
+            const auto [a, b] = split_by(nodes_[t].left, pred);
+            nodes_[t].left = b;
+            pull(t);
+            return {a, t};
+        }
+
+        // 先頭から`pred`を満たす要素が続く個数
+        template <class Pred>
+        std::size_t count_by(node_type t, const Pred &pred)
+        {
+            std::size_t count = 0;
+            while (t != NIL)
+            {
+                push(t);
+                if (pred(nodes_[t].value))
+                {
+                    count += nodes_[nodes_[t].left].size + 1;
+                    t = nodes_[t].right;
+                }
+                else
+                    t = nodes_[t].left;
+            }
+            return count;
+        }
+    };
+
+    // 永続 Treap。更新のたびに根から変更箇所までの節点だけを複製し（経路複製）、新しい根を返す
+    // 古い根は変更されず、新しい版と部分木を共有する。節点は配列の末尾に積むだけで解放しないため、
+    // 不要になった版は`compact`で残したい根から到達できる節点だけを詰め直して回収する
+    // 同じ版どうしの連結にも対応するため、優先度ではなく部分木のサイズに比例した確率で根を選んで連結する
+    template <Monoid M, typename A = NoAction<M>>
+        requires MonoidAction<A, M>
+    class PersistentTreap
+    {
+    public:
+        using value_type = typename M::value_type;
+        using action_type = typename A::value_type;
+        using node_type = std::uint32_t;
+
+        static constexpr node_type NIL = 0;
+
+        explicit PersistentTreap(std::size_t reserve_nodes = 0, std::uint64_t seed = 88172645463325252ull) : rng_(seed == 0 ? 1 : seed)
+        {
+            nodes_.reserve(reserve_nodes + 1);
+            nodes_.push_back(Node{M::identity(), M::identity(), M::identity(), A::identity(), NIL, NIL, 0, false, false});
+        }
+
+        // 確保済みの節点数（到達できない節点も含む）
+        [[nodiscard]] std::size_t node_count() const { return nodes_.size() - 1; }
+
+        // 値`val`だけを持つ木を作る
+        node_type make(const value_type &val)
+        {
+            return allocate(Node{val, val, val, A::identity(), NIL, NIL, 1, false, false});
+        }
+
+        // 範囲`range`の値をこの順に並べた木を O(n) で作る
+        template <std::ranges::input_range R>
+            requires std::convertible_to<std::ranges::range_reference_t<R>, value_type>
+        node_type build(R &&range)
+        {
+            std::vector<value_type> values;
+            for (auto &&val : range)
+                values.push_back(static_cast<value_type>(val));
+            return build_rec(values, 0, values.size());
+        }
+
+        // 木`t`の要素数
+        [[nodiscard]] std::size_t size(node_type t) const { return nodes_[t].size; }
+
+        // 木`t`の全要素の集約値
+        [[nodiscard]] value_type prod(node_type t) const { return nodes_[t].sum; }
+
+        // 木`l`の後ろに木`r`を連結した木を返す
+        node_type merge(node_type l, node_type r)
+        {
+            if (l == NIL)
+                return r;
+            if (r == NIL)
+                return l;
+            const auto sl = nodes_[l].size, sr = nodes_[r].size;
+            if (next_random() % (std::uint64_t{sl} + sr) < sl)
+            {
+                const auto t = copy_and_push(l);
+                const auto right = merge(nodes_[t].right, r);
+                nodes_[t].right = right;
+                pull(t);
+                return t;
+            }
+            const auto t = copy_and_push(r);
+            const auto left = merge(l, nodes_[t].left);
+            nodes_[t].left = left;
+            pull(t);
+            return t;
+        }
+
+        // 木`t`を先頭`k`要素とそれ以外に分割する
+        std::pair<node_type, node_type> split(node_type t, std::size_t k)
+        {
+            if (t == NIL)
+                return {NIL, NIL};
+            if (k == 0)
+                return {NIL, t};
+            if (k >= nodes_[t].size)
+                return {t, NIL};
+            t = copy_and_push(t);
+            const auto left_size = nodes_[nodes_[t].left].size;
+            if (k <= left_size)
+            {
+                const auto [a, b] = split(nodes_[t].left, k);
+                nodes_[t].left = b;
+                pull(t);
+                return {a, t};
+            }
+            const auto [a, b] = split(nodes_[t].right, k - left_size - 1);
+            nodes_[t].right = a;
+            pull(t);
+            return {t, b};
+        }
+
+        // `pos`番目の前に`val`を挿入した木を返す
+        node_type insert(node_type root, std::size_t pos, const value_type &val)
+        {
+            assert(pos <= size(root));
+            const auto [a, b] = split(root, pos);
+            return merge(merge(a, make(val)), b);
+        }
+
+        // `pos`番目の要素を削除した木を返す
+        node_type erase(node_type root, std::size_t pos)
+        {
+            assert(pos < size(root));
+            const auto [a, bc] = split(root, pos);
+            return merge(a, split(bc, 1).second);
+        }
+
+        // `pos`番目の要素を`val`にした木を返す
+        node_type set(node_type root, std::size_t pos, const value_type &val)
+        {
+            assert(pos < size(root));
+            const auto [a, bc] = split(root, pos);
+            return merge(merge(a, make(val)), split(bc, 1).second);
+        }
+
+        // 区間`[l, r)`の各要素に`f`を作用させた木を返す
+        node_type apply(node_type root, std::size_t l, std::size_t r, const action_type &f)
+        {
+            assert(l <= r && r <= size(root));
+            const auto [a, bc] = split(root, l);
+            auto [b, c] = split(bc, r - l);
+            if (b != NIL)
+            {
+                b = copy(b);
+                apply_node(b, f);
+            }
+            return merge(merge(a, b), c);
+        }
+
+        // 区間`[l, r)`を反転した木を返す
+        node_type reverse(node_type root, std::size_t l, std::size_t r)
+        {
+            assert(l <= r && r <= size(root));
+            const auto [a, bc] = split(root, l);
+            auto [b, c] = split(bc, r - l);
+            if (b != NIL)
+            {
+                b = copy(b);
+                toggle_reverse(b);
+            }
+            return merge(merge(a, b), c);
+        }
+
+        // `pos`番目の要素を返す（節点を作らない）
+        [[nodiscard]] value_type get(node_type root, std::size_t pos) const
+        {
+            assert(pos < size(root));
+            return get_rec(root, pos, false);
+        }
+
+        // 区間`[l, r)`の集約値（節点を作らない）
+        [[nodiscard]] value_type prod(node_type root, std::size_t l, std::size_t r) const
+        {
+            assert(l <= r && r <= size(root));
+            return prod_rec(root, l, r, false);
+        }
+
+        // 木`t`の要素を順に並べて返す
+        [[nodiscard]] std::vector<value_type> to_vector(node_type t) const
+        {
+            std::vector<value_type> result;
+            result.reserve(size(t));
+            collect(t, false, A::identity(), false, result);
+            return result;
+        }
+
+        // `roots`から到達できる節点だけを新しい配列に詰め直し、`roots`を新しい番号に書き換える
+        // `roots`に含まれない版の根はこれ以降使えない。部分木の共有は保たれる
+        void compact(std::span<node_type> roots)
+        {
+            std::vector<node_type> remap(nodes_.size(), NIL);
+            std::vector<Node> compacted;
+            compacted.push_back(nodes_[NIL]);
+            // 帰りがけ順に複製し、子の新しい番号が先に決まるようにする
+            std::vector<std::pair<node_type, bool>> stack;
+            for (const auto root : roots)
+            {
+                if (root != NIL)
+                    stack.emplace_back(root, false);
+                while (!stack.empty())
+                {
+                    const auto [t, expanded] = stack.back();
+                    stack.pop_back();
+                    if (remap[t] != NIL)
+                        continue;
+                    const auto &node = nodes_[t];
+                    if (!expanded)
+                    {
+                        stack.emplace_back(t, true);
+                        for (const auto child : {node.left, node.right})
+                        {
+                            if (child != NIL && remap[child] == NIL)
+                                stack.emplace_back(child, false);
+                        }
+                        continue;
+                    }
+                    auto moved = node;
+                    moved.left = remap[node.left];
+                    moved.right = remap[node.right];
+                    remap[t] = static_cast<node_type>(compacted.size());
+                    compacted.push_back(std::move(moved));
+                }
+            }
+            for (auto &root : roots)
+                root = remap[root];
+            nodes_ = std::move(compacted);
+        }
+
+        void compact(std::vector<node_type> &roots) { compact(std::span<node_type>(roots)); }
+
+    private:
+        struct Node
+        {
+            value_type value, sum, rsum;
+            [[no_unique_address]] action_type lazy;
+            node_type left, right;
+            std::uint32_t size;
+            bool pending, reversed;
+        };
+
+        std::vector<Node> nodes_;
+        std::uint64_t rng_;
+
+        std::uint64_t next_random()
+        {
+            // xorshift64
+            rng_ ^= rng_ << 13;
+            rng_ ^= rng_ >> 7;
+            rng_ ^= rng_ << 17;
+            return rng_;
+        }
+
+        node_type allocate(Node node)
+        {
+            assert(nodes_.size() < std::numeric_limits<node_type>::max());
+            nodes_.push_back(std::move(node));
+            return static_cast<node_type>(nodes_.size() - 1);
+        }
+
+        node_type copy(node_type t)
+        {
+            // `push_back`で`nodes_`が再確保されうるので、先に値を取り出す
+            auto node = nodes_[t];
+            return allocate(std::move(node));
+        }
+
+        void pull(node_type t)
+        {
+            auto &node = nodes_[t];
+            const auto &l = nodes_[node.left];
+            const auto &r = nodes_[node.right];
+            node.size = l.size + r.size + 1;
+            node.sum = M::op(M::op(l.sum, node.value), r.sum);
+            node.rsum = M::op(M::op(r.rsum, node.value), l.rsum);
+        }
+
+        // 複製した節点`t`の部分木を反転する（子の入れ替えは`copy_and_push`まで遅らせる）
+        void toggle_reverse(node_type t)
+        {
+            auto &node = nodes_[t];
+            std::swap(node.sum, node.rsum);
+            node.reversed ^= true;
+        }
+
+        // 複製した節点`t`に作用を適用する
+        void apply_node(node_type t, const action_type &f)
+        {
+            if constexpr (!std::same_as<A, NoAction<M>>)
+            {
+                auto &node = nodes_[t];
+                node.value = A::act(f, node.value);
+                node.sum = A::act(f, node.sum);
+                node.rsum = A::act(f, node.rsum);
+                node.lazy = node.pending ? A::op(f, node.lazy) : f;
+                node.pending = true;
+            }
+        }
+
+        // 節点`t`を複製し、溜まっている作用・反転を（複製した）子に伝えたものを返す
+        node_type copy_and_push(node_type t)
+        {
+            t = copy(t);
+            if (!nodes_[t].pending && !nodes_[t].reversed)
+                return t;
+            auto left = nodes_[t].left, right = nodes_[t].right;
+            if (nodes_[t].reversed)
+                std::swap(left, right);
+            for (auto *child : {&left, &right})
+            {
+                if (*child == NIL)
+                    continue;
+                *child = copy(*child);
+                if (nodes_[t].reversed)
+                    toggle_reverse(*child);
+                if (nodes_[t].pending)
+                    apply_node(*child, nodes_[t].lazy);
+            }
+            auto &node = nodes_[t];
+            node.left = left;
+            node.right = right;
+            node.pending = node.reversed = false;
+            node.lazy = A::identity();
+            return t;
+        }
+
+        node_type build_rec(const std::vector<value_type> &values, std::size_t first, std::size_t last)
+        {
+            if (first == last)
+                return NIL;
+            const auto mid = first + (last - first) / 2;
+            const auto left = build_rec(values, first, mid);
+            const auto right = build_rec(values, mid + 1, last);
+            const auto t = make(values[mid]);
+            nodes_[t].left = left;
+            nodes_[t].right = right;
+            pull(t);
+            return t;
+        }
+
+        // 以下の読み取り専用の操作では、祖先の作用は子の集約値に含まれていないため、戻りがけに作用させる
+        // `rev`は祖先で反転が指定された回数の偶奇（節点自身の`sum`/`rsum`には自身の反転が反映済み）
+        value_type get_rec(node_type t, std::size_t pos, bool rev) const
+        {
+            const auto &node = nodes_[t];
+            rev ^= node.reversed;
+            const auto first = rev ? node.right : node.left, second = rev ? node.left : node.right;
+            const auto first_size = nodes_[first].size;
+            if (pos == first_size)
+                return node.value;
+            auto val = pos < first_size ? get_rec(first, pos, rev) : get_rec(second, pos - first_size - 1, rev);
+            if constexpr (!std::same_as<A, NoAction<M>>)
+            {
+                if (node.pending)
+                    val = A::act(node.lazy, val);
+            }
+            return val;
+        }
+
+        value_type prod_rec(node_type t, std::size_t l, std::size_t r, bool rev) const
+        {
+            const auto &node = nodes_[t];
+            if (l >= r || t == NIL)
+                return M::identity();
+            if (l == 0 && r == node.size)
+                return rev ? node.rsum : node.sum;
+            rev ^= node.reversed;
+            const auto first = rev ? node.right : node.left, second = rev ? node.left : node.right;
+            const auto first_size = nodes_[first].size;
+            auto left_part = prod_rec(first, l, std::min<std::size_t>(r, first_size), rev);
+            auto right_part = r > first_size + 1 ? prod_rec(second, l > first_size + 1 ? l - first_size - 1 : 0, r - first_size - 1, rev) : M::identity();
+            if constexpr (!std::same_as<A, NoAction<M>>)
+            {
+                if (node.pending)
+                {
+                    left_part = A::act(node.lazy, left_part);
+                    right_part = A::act(node.lazy, right_part);
+                }
+            }
+            const bool contains_node = l <= first_size && first_size < r;
+            return contains_node ? M::op(M::op(left_part, node.value), right_part) : M::op(left_part, right_part);
+        }
+
+        // `f`：祖先の作用を合成したもの（`has_f`が偽なら恒等写像）
+        void collect(node_type t, bool rev, const action_type &f, bool has_f, std::vector<value_type> &out) const
+        {
+            if (t == NIL)
+                return;
+            const auto &node = nodes_[t];
+            rev ^= node.reversed;
+            auto g = f;
+            auto has_g = has_f;
+            if constexpr (!std::same_as<A, NoAction<M>>)
+            {
+                if (node.pending)
+                {
+                    g = has_f ? A::op(f, node.lazy) : node.lazy;
+                    has_g = true;
+                }
+            }
+            collect(rev ? node.right : node.left, rev, g, has_g, out);
+            if constexpr (!std::same_as<A, NoAction<M>>)
+                out.push_back(has_f ? static_cast<value_type>(A::act(f, node.value)) : node.value);
+            else
+                out.push_back(node.value);
+            collect(rev ? node.left : node.right, rev, g, has_g, out);
+        }
+    };
+}
@@ -1,8 +1,14 @@
+#pragma once
 #include <vector>
 #include <numeric>
 #include <cstddef>
 #include <utility>
 #include <ranges>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include "../concepts/algebra_concepts.hpp"
 
 namespace gcl
 {
@@ -19,11 +25,15 @@ namespace gcl
         }
 
         // `id`の所属する集合の代表元を返す
+        // 再帰を使わず、経路半減（親を祖父に付け替える）で経路を短くする
         [[nodiscard]] std::size_t find(std::size_t id)
         {
-            if (_parent[id] == id)
-                return id;
-            return _parent[id] = find(_parent[id]);
+            while (_parent[id] != id)
+            {
+                _parent[id] = _parent[_parent[id]];
+                id = _parent[id];
+            }
+            return id;
         }
 
         // `id`の所属する集合のサイズを返す
@@ -58,4 +68,242 @@ namespace gcl
     private:
         std::vector<std::size_t> _size, _parent;
     };
+
+    // 1要素あたり`sizeof(Index)`バイトで動作するUnionFind
+    // 根では`-(集合のサイズ)`、それ以外では親の番号を1本の配列に持つ
+    // `Index`の正の範囲に要素数が収まる必要がある
+    template <std::signed_integral Index = std::int32_t>
+    class CompactUnionFind
+    {
+    public:
+        using index_type = Index;
+
+        /*
+            @brief n 要素のUnionFindを構築する
+        */
+        explicit CompactUnionFind(std::size_t size) : _data(size, Index{-1})
+        {
+            assert(size <= static_cast<std::size_t>(std::numeric_limits<Index>::max()));
+        }
+
+        // `id`の所属する集合の代表元を返す（経路半減）
+        [[nodiscard]] std::size_t find(std::size_t id)
+        {
+            auto v = static_cast<Index>(id);
+            while (_data[v] >= 0)
+            {
+                const auto p = _data[v];
+                if (_data[p] >= 0)
+                    _data[v] = _data[p];
+                v = _data[v];
+            }
+            return static_cast<std::size_t>(v);
+        }
+
+        // `id`の所属する集合のサイズを返す
+        [[nodiscard]] std::size_t size(std::size_t id)
+        {
+            return static_cast<std::size_t>(-_data[find(id)]);
+        }
+
+        // `left`と`right`の所属する集合が等しいか返す
+        [[nodiscard]] bool same(std::size_t left, std::size_t right)
+        {
+            return find(left) == find(right);
+        }
+
+        // `left`と`right`の所属する集合を結合する
+        // サイズが同じ集合同士は左に結合
+        bool unite(std::size_t left, std::size_t right)
+        {
+            auto root_left = find(left);
+            auto root_right = find(right);
+            if (root_left == root_right)
+                return false;
+            // サイズは負で持っているので大小が逆になる
+            if (_data[root_left] > _data[root_right])
+                std::swap(root_left, root_right);
+            _data[root_left] += _data[root_right];
+            _data[root_right] = static_cast<Index>(root_left);
+            return true;
+        }
+
+    private:
+        std::vector<Index> _data;
+    };
+
+    // 結合を取り消せるUnionFind（union by size のみで経路圧縮を行わない）
+    // `find`は O(log N)。結合のたびに付け替えた根を履歴に積み、新しい順に取り消す
+    class RollbackUnionFind
+    {
+    public:
+        /*
+            @brief n 要素のUnionFindを構築する
+        */
+        explicit RollbackUnionFind(std::size_t size) : _size(size, std::size_t{1}), _parent(size)
+        {
+            std::iota(_parent.begin(), _parent.end(), 0);
+        }
+
+        // `id`の所属する集合の代表元を返す
+        [[nodiscard]] std::size_t find(std::size_t id) const
+        {
+            while (_parent[id] != id)
+                id = _parent[id];
+            return id;
+        }
+
+        // `id`の所属する集合のサイズを返す
+        [[nodiscard]] std::size_t size(std::size_t id) const
+        {
+            return _size[find(id)];
+        }
+
+        // `left`と`right`の所属する集合が等しいか返す
+        [[nodiscard]] bool same(std::size_t left, std::size_t right) const
+        {
+            return find(left) == find(right);
+        }
+
+        // `left`と`right`の所属する集合を結合する
+        // サイズが同じ集合同士は左に結合。結合しなかった場合は履歴に何も積まない
+        bool unite(std::size_t left, std::size_t right)
+        {
+            auto root_left = find(left);
+            auto root_right = find(right);
+            if (root_left == root_right)
+                return false;
+            if (_size[root_left] < _size[root_right])
+                std::swap(root_left, root_right);
+            _parent[root_right] = root_left;
+            _size[root_left] += _size[root_right];
+            _history.push_back(root_right);
+            return true;
+        }
+
+        // 最後に成功した`unite`を取り消す
+        void undo()
+        {
+            assert(!_history.empty());
+            const auto child = _history.back();
+            _history.pop_back();
+            _size[_parent[child]] -= _size[child];
+            _parent[child] = child;
+        }
+
+        // 現在の状態を表す値（これまでに成功した`unite`の回数）を返す
+        [[nodiscard]] std::size_t snapshot() const { return _history.size(); }
+
+        // `snapshot()`が`state`を返した時点の状態に戻す
+        void rollback(std::size_t state)
+        {
+            assert(state <= _history.size());
+            while (_history.size() > state)
+                undo();
+        }
+
+    private:
+        std::vector<std::size_t> _size, _parent, _history;
+    };
+
+    // `WeightedUnionFind`のポテンシャルに使える型（加減算が出来て等価比較が出来る）
+    template <typename T>
+    concept PotentialLike = ModuleLike<T> && std::equality_comparable<T>;
+
+    // 各要素にポテンシャル`x_v`を持ち、`x_v - x_u = w`という制約を管理するUnionFind
+    // 親へのリンクごとに`x_v - x_parent`を持ち、経路圧縮の際に足し合わせる
+    template <PotentialLike W>
+    class WeightedUnionFind
+    {
+    public:
+        /*
+            @brief n 要素のUnionFindを構築する（全てのポテンシャルは互いに無関係）
+        */
+        explicit WeightedUnionFind(std::size_t size) : _size(size, std::size_t{1}), _parent(size), _diff(size)
+        {
+            std::iota(_parent.begin(), _parent.end(), 0);
+        }
+
+        // `id`の所属する集合の代表元を返す
+        [[nodiscard]] std::size_t find(std::size_t id)
+        {
+            auto root = id;
+            W total{};
+            while (_parent[root] != root)
+            {
+                total += _diff[root];
+                root = _parent[root];
+            }
+            // 経路上の各要素を根に直接繋ぎ、根からの差に付け替える
+            while (_parent[id] != root && id != root)
+            {
+                const auto next = _parent[id];
+                const auto d = _diff[id];
+                _parent[id] = root;
+                _diff[id] = total;
+                total -= d;
+                id = next;
+            }
+            return root;
+        }
+
+        // `x_id - x_root`を返す
+        [[nodiscard]] W weight(std::size_t id)
+        {
+            // 経路圧縮の後は`id`が根に直接繋がっているので、`_diff[id]`が根からの差になる
+            const auto root = find(id);
+            return id == root ? W{} : _diff[id];
+        }
+
+        // `x_right - x_left`を返す（`left`と`right`は同じ集合に属する必要がある）
+        [[nodiscard]] W diff(std::size_t left, std::size_t right)
+        {
+            assert(same(left, right));
+            return weight(right) - weight(left);
+        }
+
+        // `id`の所属する集合のサイズを返す
+        [[nodiscard]] std::size_t size(std::size_t id)
+        {
+            return _size[find(id)];
+        }
+
+        // `left`と`right`の所属する集合が等しいか返す
+        [[nodiscard]] bool same(std::size_t left, std::size_t right)
+        {
+            return find(left) == find(right);
+        }
+
+        // 制約`x_right - x_left = w`を追加する
+        // 既存の制約と矛盾する場合は何もせず`false`を、そうでなければ`true`を返す
+        // サイズが同じ集合同士は左に結合
+        bool unite(std::size_t left, std::size_t right, W w)
+        {
+            auto root_left = find(left);
+            auto root_right = find(right);
+            const auto weight_left = weight(left);
+            const auto weight_right = weight(right);
+            if (root_left == root_right)
+                return weight_right - weight_left == w;
+            if (_size[root_left] < _size[root_right])
+            {
+                // `x_root_left - x_root_right`
+                _diff[root_left] = weight_right - weight_left - w;
+                _parent[root_left] = root_right;
+                _size[root_right] += _size[root_left];
+            }
+            else
+            {
+                // `x_root_right - x_root_left`
+                _diff[root_right] = w + weight_left - weight_right;
+                _parent[root_right] = root_left;
+                _size[root_left] += _size[root_right];
+            }
+            return true;
+        }
+
+    private:
+        std::vector<std::size_t> _size, _parent;
+        std::vector<W> _diff;
+    };
 }
@@ -7,6 +7,7 @@ from pathlib import Path
 from typing import List, Set, Optional
 
 INCLUDE_RE = re.compile(r'^\s*#\s*include\s*([<"])([^>"]+)[>"]\s*$')
+PRAGMA_ONCE_RE = re.compile(r"^\s*#\s*pragma\s+once\s*$")
 
 
 def find_project_root(script_path: Path) -> Path:
@@ -88,6 +89,10 @@ def expand_file(
         out.append(f"// ===== BEGIN {display_path(path, root)} =====\n")
 
     for line in lines:
+        # 展開後は単一ファイルになるため不要（残すと警告が出る）
+        if PRAGMA_ONCE_RE.match(line):
+            continue
+
         m = INCLUDE_RE.match(line)
         if not m:
             out.append(line)
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+#include "../algorithm/bfs.hpp"
+
+namespace
+{
+    // `dist`と`parent`が`graph`上の正しい幅優先探索木になっているか確認する
+    void expect_valid_bfs_tree(const gcl::Graph &graph, const gcl::DijkstraResult<std::size_t> &result, const std::vector<std::size_t> &expected_dist)
+    {
+        ASSERT_EQ(result.dist, expected_dist);
+        for (std::size_t v = 0; v < graph.size(); v++)
+        {
+            if (v == result.start || result.dist[v] == std::numeric_limits<std::size_t>::max())
+            {
+                EXPECT_EQ(result.parent[v], gcl::npos);
+                continue;
+            }
+            const auto p = result.parent[v];
+            ASSERT_NE(p, gcl::npos);
+            EXPECT_EQ(result.dist[p] + 1, result.dist[v]);
+            bool has_edge = false;
+            for (const auto &e : graph[p])
+                has_edge |= e.to == v;
+            EXPECT_TRUE(has_edge);
+        }
+    }
+}
+
+TEST(BFS, SmallGraph)
+{
+    gcl::Graph graph(5);
+    graph[0].emplace_back(1);
+    graph[1].emplace_back(2);
+    graph[0].emplace_back(3);
+    graph[3].emplace_back(2);
+    auto result = gcl::bfs(graph, 0);
+    constexpr auto INF = std::numeric_limits<std::size_t>::max();
+    EXPECT_EQ(result.dist, (std::vector<std::size_t>{0, 1, 2, 1, INF}));
+    EXPECT_EQ(result.restore_path(2).size(), 3u);
+    EXPECT_TRUE(result.restore_path(4).empty());
+}
+
+TEST(BFS, MatchesDijkstraWithUnitWeights)
+{
+    const std::size_t n = 300;
+    gcl::Graph graph(n);
+    gcl::WGraph<std::size_t> weighted(n);
+    std::mt19937 rng(12345);
+    for (int i = 0; i < 900; i++)
+    {
+        const auto u = rng() % n, v = rng() % n;
+        graph[u].emplace_back(v);
+        weighted[u].emplace_back(v, 1);
+    }
+    const auto result = gcl::bfs(graph, 0);
+    expect_valid_bfs_tree(graph, result, gcl::dijkstra_dist(weighted, 0));
+}
+
+TEST(ZeroOneBFS, MatchesDijkstra)
+{
+    const std::size_t n = 300;
+    gcl::WGraph<int> graph(n);
+    std::mt19937 rng(12345);
+    for (int i = 0; i < 1200; i++)
+    {
+        const auto u = rng() % n, v = rng() % n;
+        graph[u].emplace_back(v, static_cast<int>(rng() % 2));
+    }
+    const auto result = gcl::zero_one_bfs(graph, 0);
+    EXPECT_EQ(result.dist, gcl::dijkstra_dist(graph, 0));
+    for (std::size_t v = 1; v < n; v++)
+    {
+        if (result.dist[v] == std::numeric_limits<int>::max())
+            continue;
+        // 復元した経路の重みの和が距離に一致する
+        const auto path = result.restore_path(v);
+        ASSERT_FALSE(path.empty());
+        int total = 0;
+        for (std::size_t i = 0; i + 1 < path.size(); i++)
+        {
+            int best = std::numeric_limits<int>::max();
+            for (const auto &e : graph[path[i]])
+            {
+                if (e.to == path[i + 1])
+                    best = std::min(best, e.weight);
+            }
+            total += best;
+        }
+        EXPECT_EQ(total, result.dist[v]);
+    }
+}
+
+TEST(DirectionOptimizingBFS, UndirectedMatchesBFS)
+{
+    // 直径の小さいランダムグラフ（ボトムアップの段を通る）
+    const std::size_t n = 5000;
+    gcl::Graph graph(n);
+    std::mt19937 rng(12345);
+    for (int i = 0; i < 40000; i++)
+    {
+        const auto u = rng() % n, v = rng() % n;
+        graph[u].emplace_back(v);
+        graph[v].emplace_back(u);
+    }
+    const auto expected = gcl::bfs(graph, 0).dist;
+    expect_valid_bfs_tree(graph, gcl::direction_optimizing_bfs(graph, 0), expected);
+    expect_valid_bfs_tree(graph, gcl::direction_optimizing_bfs(graph, 0, {.n_threads = 3}), expected);
+    // 全ての段をボトムアップ / トップダウンで処理する
+    expect_valid_bfs_tree(graph, gcl::direction_optimizing_bfs(graph, 0, {.direction = gcl::BfsDirection::bottom_up}), expected);
+    expect_valid_bfs_tree(graph, gcl::direction_optimizing_bfs(graph, 0, {.n_threads = 3, .direction = gcl::BfsDirection::bottom_up}), expected);
+    expect_valid_bfs_tree(graph, gcl::direction_optimizing_bfs(graph, 0, {.direction = gcl::BfsDirection::top_down}), expected);
+    // 未探索の辺の数の`1 / alpha`が 0 になり、前線の頂点数は常に`n / beta`を下回るので、段ごとに向きが入れ替わる
+    expect_valid_bfs_tree(graph, gcl::direction_optimizing_bfs(graph, 0, {.alpha = n * 100, .beta = 1}), expected);
+}
+
+TEST(DirectionOptimizingBFS, DirectedWithReverse)
+{
+    const std::size_t n = 1000;
+    gcl::Graph graph(n), reverse(n);
+    std::mt19937 rng(12345);
+    for (int i = 0; i < 5000; i++)
+    {
+        const auto u = rng() % n, v = rng() % n;
+        graph[u].emplace_back(v);
+        reverse[v].emplace_back(u);
+    }
+    const auto expected = gcl::bfs(graph, 7).dist;
+    expect_valid_bfs_tree(graph, gcl::direction_optimizing_bfs(graph, reverse, 7), expected);
+    expect_valid_bfs_tree(graph, gcl::direction_optimizing_bfs(graph, reverse, 7, {.n_threads = 2, .direction = gcl::BfsDirection::bottom_up}), expected);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include "../algorithm/connected_components.hpp"
+#include "../data-structure/concurrent_unionfind.hpp"
+#include "../data-structure/unionfind.hpp"
+
+TEST(ConcurrentUnionFind, SingleThreaded)
+{
+    gcl::ConcurrentUnionFind<> uf(5);
+    EXPECT_TRUE(uf.unite(3, 4));
+    EXPECT_TRUE(uf.unite(1, 3));
+    EXPECT_FALSE(uf.unite(4, 1));
+    EXPECT_TRUE(uf.same(1, 4));
+    EXPECT_FALSE(uf.same(0, 4));
+    // 代表元は集合内の最小の要素番号
+    EXPECT_EQ(uf.find(4), std::size_t{1});
+    EXPECT_EQ(uf.size(4), std::size_t{3});
+    EXPECT_EQ(uf.size(0), std::size_t{1});
+}
+
+TEST(ConcurrentUnionFind, ConcurrentUnitesMatchUnionFind)
+{
+    const std::size_t N = 20000, M = 30000, THREADS = 4;
+    std::mt19937 rng(7);
+    std::vector<std::pair<std::size_t, std::size_t>> pairs(M);
+    for (auto &[a, b] : pairs)
+        a = rng() % N, b = rng() % N;
+
+    gcl::UnionFind expected(N);
+    std::size_t expected_unions = 0;
+    for (auto [a, b] : pairs)
+        expected_unions += expected.unite(a, b);
+
+    gcl::ConcurrentUnionFind<> uf(N);
+    std::atomic<std::size_t> unions{0};
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t t = 0; t < THREADS; t++)
+            threads.emplace_back([&, t]
+                                 {
+                                     for (auto i = t; i < M; i += THREADS)
+                                         unions += uf.unite(pairs[i].first, pairs[i].second);
+                                 });
+    }
+    // 結合に成功した回数は、どの順序で処理しても同じ
+    EXPECT_EQ(unions.load(), expected_unions);
+    for (std::size_t v = 0; v < N; v++)
+    {
+        EXPECT_EQ(uf.same(v, 0), expected.same(v, 0));
+        EXPECT_EQ(uf.size(v), expected.size(v));
+    }
+}
+
+TEST(ParallelConnectedComponents, EdgeListAndGraph)
+{
+    const std::size_t N = 5000;
+    std::mt19937 rng(1);
+    std::vector<gcl::UWEdge<int>> edges;
+    gcl::WGraph<int> wg(N);
+    gcl::Graph g(N);
+    for (std::size_t i = 0; i < N; i++)
+    {
+        std::size_t u = rng() % N, v = rng() % N;
+        edges.emplace_back(u, v, 1);
+        wg[u].push_back({v, 1});
+        g[u].push_back(v);
+    }
+
+    gcl::UnionFind uf(N);
+    for (const auto &e : edges)
+        uf.unite(e.from, e.to);
+    std::vector<std::size_t> expected(N, N);
+    for (std::size_t v = 0; v < N; v++)
+    {
+        auto &m = expected[uf.find(v)];
+        m = std::min(m, v);
+    }
+    for (std::size_t v = 0; v < N; v++)
+        expected[v] = expected[uf.find(v)];
+
+    for (std::size_t threads : {1, 3, 8})
+    {
+        EXPECT_EQ(gcl::parallel_connected_components(N, edges, threads), expected);
+        EXPECT_EQ(gcl::parallel_connected_components(wg, threads), expected);
+        EXPECT_EQ(gcl::parallel_connected_components(g, threads), expected);
+    }
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "../data-structure/csr_graph.hpp"
+#include "../algorithm/shortest_path.hpp"
+#include "../algorithm/minimum_spanning_tree.hpp"
+
+using ull = std::uint64_t;
+
+TEST(CSRGraph, SatisfiesWeightedGraph)
+{
+    static_assert(gcl::WeightedGraph<gcl::CSRGraph<std::uint64_t>>);
+    static_assert(gcl::WeightedGraph<gcl::CSRGraph<std::int64_t>>);
+    static_assert(gcl::WeightedGraph<gcl::CSRGraph<std::int32_t, std::uint64_t>>);
+    static_assert(std::same_as<gcl::weight_t<gcl::CSRGraph<std::int64_t>>, std::int64_t>);
+}
+
+TEST(CSRGraph, FromWGraphKeepsAdjacencyOrder)
+{
+    gcl::WGraph<ull> g(3);
+    g[0].push_back({2, 7});
+    g[0].push_back({1, 5});
+    g[2].push_back({0, 1});
+
+    gcl::CSRGraph<ull> csr(g);
+    ASSERT_EQ(csr.size(), std::size_t{3});
+    EXPECT_EQ(csr.num_edges(), std::size_t{3});
+    EXPECT_EQ(csr.degree(0), std::size_t{2});
+    EXPECT_EQ(csr.degree(1), std::size_t{0});
+
+    std::vector<std::pair<std::size_t, ull>> adj0;
+    for (const auto &e : csr[0])
+        adj0.emplace_back(e.to, e.weight);
+    EXPECT_EQ(adj0, (std::vector<std::pair<std::size_t, ull>>{{2, 7}, {1, 5}}));
+    EXPECT_TRUE(csr[1].empty());
+}
+
+TEST(CSRGraph, FromEdgeList)
+{
+    std::vector<gcl::UWEdge<ull>> edges{{0, 1, 4}, {1, 2, 3}, {0, 2, 9}};
+
+    gcl::CSRGraph<ull> directed(3, edges);
+    EXPECT_EQ(directed.num_edges(), std::size_t{3});
+    EXPECT_EQ(directed.degree(2), std::size_t{0});
+
+    gcl::CSRGraph<ull> undirected(3, edges, true);
+    EXPECT_EQ(undirected.num_edges(), std::size_t{6});
+    EXPECT_EQ(undirected.degree(2), std::size_t{2});
+}
+
+TEST(CSRGraph, DijkstraMatchesWGraph)
+{
+    gcl::WGraph<ull> g(4);
+    g[0].push_back({1, 2});
+    g[1].push_back({2, 3});
+    g[1].push_back({3, 1});
+    g[2].push_back({0, 1});
+    g[2].push_back({3, 4});
+    g[3].push_back({2, 1});
+
+    gcl::CSRGraph<ull> csr(g);
+    EXPECT_EQ(gcl::dijkstra_dist(csr, 0), gcl::dijkstra_dist(g, 0));
+
+    auto res = gcl::dijkstra_path(csr, 0);
+    EXPECT_EQ(res.restore_path(2), (std::vector<std::size_t>{0, 1, 3, 2}));
+}
+
+TEST(CSRGraph, BellmanFordAndKruskal)
+{
+    using ll = long long;
+    std::vector<gcl::UWEdge<ll>> edges{{0, 1, 1}, {1, 2, 2}, {2, 3, 3}, {0, 3, 10}, {0, 2, 5}};
+
+    gcl::CSRGraph<ll> directed(4, edges);
+    auto bf = gcl::bellman_ford(directed, 0);
+    EXPECT_FALSE(bf.negative_cycle_exist);
+    EXPECT_EQ(bf.dist, (std::vector<ll>{0, 1, 3, 6}));
+
+    gcl::CSRGraph<ll> undirected(4, edges, true);
+    auto mst = gcl::kruskal(undirected);
+    EXPECT_TRUE(mst.is_connected);
+    EXPECT_EQ(mst.total_weight, 6);
+    EXPECT_EQ(mst.edges.size(), std::size_t{3});
+}
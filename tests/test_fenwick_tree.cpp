@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <random>
 #include "../data-structure/fenwick_tree.hpp"
 
 TEST(FenwickTree, DefaultConstructor)
@@ -75,3 +76,184 @@ TEST(FenwickTree, Size)
     gcl::FenwickTree<int> ft(v);
     EXPECT_EQ(ft.size(), size);
 }
+
+TEST(FenwickTree, LinearConstructionMatchesAdd)
+{
+    std::vector<long long> v(1000);
+    for (std::size_t i = 0; i < v.size(); i++)
+        v[i] = static_cast<long long>((i * 7919) % 101) - 50;
+    gcl::FenwickTree<long long> built(v), added(v.size());
+    for (std::size_t i = 0; i < v.size(); i++)
+        added.add(i, v[i]);
+    for (std::size_t i = 0; i < v.size(); i++)
+    {
+        EXPECT_EQ(built.get(i), v[i]);
+        EXPECT_EQ(built.sum(0, i), added.sum(0, i));
+    }
+}
+
+TEST(FenwickTree, LowerBound)
+{
+    std::vector<int> v = {3, 0, 2, 5, 0, 1};
+    gcl::FenwickTree<int> ft(v);
+    // prefix sums: 3, 3, 5, 10, 10, 11
+    EXPECT_EQ(ft.lower_bound(0), 0u);
+    EXPECT_EQ(ft.lower_bound(1), 0u);
+    EXPECT_EQ(ft.lower_bound(3), 0u);
+    EXPECT_EQ(ft.lower_bound(4), 2u);
+    EXPECT_EQ(ft.lower_bound(10), 3u);
+    EXPECT_EQ(ft.lower_bound(11), 5u);
+    EXPECT_EQ(ft.lower_bound(12), 6u);
+
+    for (int w = 0; w <= 12; w++)
+    {
+        std::size_t expected = 0;
+        while (expected < v.size() && ft.sum(0, expected + 1) < w)
+            expected++;
+        EXPECT_EQ(ft.lower_bound(w), expected);
+    }
+}
+
+namespace
+{
+    // 乗算を持たない型（倍々の加算で`k`倍を求める経路を通す）
+    struct Additive
+    {
+        long long x = 0;
+        Additive() = default;
+        explicit Additive(long long x_) : x(x_) {}
+        Additive operator+(const Additive &o) const { return Additive(x + o.x); }
+        Additive operator-(const Additive &o) const { return Additive(x - o.x); }
+        Additive &operator+=(const Additive &o) { return x += o.x, *this; }
+        Additive &operator-=(const Additive &o) { return x -= o.x, *this; }
+    };
+}
+
+TEST(RangeAddFenwickTree, MatchesNaive)
+{
+    std::vector<long long> naive(50);
+    for (std::size_t i = 0; i < naive.size(); i++)
+        naive[i] = static_cast<long long>(i % 7);
+    gcl::RangeAddFenwickTree<long long> ft(naive);
+    gcl::RangeAddFenwickTree<Additive> ft2(naive.size());
+    for (std::size_t i = 0; i < naive.size(); i++)
+        ft2.add(i, Additive(naive[i]));
+
+    std::mt19937 rng(12345);
+    for (int it = 0; it < 500; it++)
+    {
+        std::size_t l = rng() % (naive.size() + 1), r = rng() % (naive.size() + 1);
+        if (l > r)
+            std::swap(l, r);
+        const long long val = static_cast<long long>(rng() % 21) - 10;
+        if (it % 2 == 0)
+        {
+            ft.add(l, r, val);
+            ft2.add(l, r, Additive(val));
+            for (auto i = l; i < r; i++)
+                naive[i] += val;
+        }
+        long long expected = 0;
+        for (auto i = l; i < r; i++)
+            expected += naive[i];
+        EXPECT_EQ(ft.sum(l, r), expected);
+        EXPECT_EQ(ft2.sum(l, r).x, expected);
+    }
+    for (std::size_t i = 0; i < naive.size(); i++)
+        EXPECT_EQ(ft.get(i), naive[i]);
+    EXPECT_EQ(ft.size(), naive.size());
+}
+
+TEST(BlockedFenwickTree, MatchesFenwickTree)
+{
+    std::vector<long long> v(1000);
+    for (std::size_t i = 0; i < v.size(); i++)
+        v[i] = static_cast<long long>((i * 7919) % 101);
+    gcl::FenwickTree<long long> ft(v);
+    gcl::BlockedFenwickTree<long long, 16> built(v), added(v.size());
+    for (std::size_t i = 0; i < v.size(); i++)
+        added.add(i, v[i]);
+
+    std::mt19937 rng(12345);
+    for (int it = 0; it < 2000; it++)
+    {
+        std::size_t l = rng() % (v.size() + 1), r = rng() % (v.size() + 1);
+        if (l > r)
+            std::swap(l, r);
+        if (it % 2 == 0 && l < v.size())
+        {
+            const long long val = static_cast<long long>(rng() % 50);
+            ft.add(l, val);
+            built.add(l, val);
+            added.add(l, val);
+        }
+        EXPECT_EQ(built.sum(l, r), ft.sum(l, r));
+        EXPECT_EQ(added.sum(l, r), ft.sum(l, r));
+        const long long w = static_cast<long long>(rng() % static_cast<std::uint64_t>(ft.sum(0, v.size()) + 2));
+        EXPECT_EQ(built.lower_bound(w), ft.lower_bound(w));
+    }
+    for (std::size_t i = 0; i < v.size(); i++)
+        EXPECT_EQ(built.get(i), ft.get(i));
+    EXPECT_EQ(built.size(), v.size());
+}
+
+TEST(BlockedFenwickTree, LowerBoundPastPartialBlock)
+{
+    // 最後のブロックが埋まっていない場合でも`size()`を返す
+    gcl::BlockedFenwickTree<int, 8> ft(std::vector<int>{1, 1, 1, 1, 1, 1, 1, 1, 1, 1});
+    EXPECT_EQ(ft.lower_bound(10), 9u);
+    EXPECT_EQ(ft.lower_bound(11), 10u);
+}
+
+TEST(FenwickTreeND, TwoDimensionalMatchesNaive)
+{
+    const std::size_t h = 13, w = 7;
+    std::vector<long long> grid(h * w);
+    for (std::size_t i = 0; i < grid.size(); i++)
+        grid[i] = static_cast<long long>((i * 31) % 17) - 8;
+    gcl::FenwickTreeND<long long, 2> ft({h, w}, grid);
+    EXPECT_EQ(ft.size(), h * w);
+
+    std::mt19937 rng(12345);
+    for (int it = 0; it < 500; it++)
+    {
+        std::size_t r0 = rng() % (h + 1), r1 = rng() % (h + 1);
+        std::size_t c0 = rng() % (w + 1), c1 = rng() % (w + 1);
+        if (r0 > r1)
+            std::swap(r0, r1);
+        if (c0 > c1)
+            std::swap(c0, c1);
+        if (it % 2 == 0 && r0 < h && c0 < w)
+        {
+            const long long val = static_cast<long long>(rng() % 9) - 4;
+            ft.add({r0, c0}, val);
+            grid[r0 * w + c0] += val;
+        }
+        long long expected = 0;
+        for (auto i = r0; i < r1; i++)
+            for (auto j = c0; j < c1; j++)
+                expected += grid[i * w + j];
+        EXPECT_EQ(ft.sum({r0, c0}, {r1, c1}), expected);
+    }
+    for (std::size_t i = 0; i < h; i++)
+        for (std::size_t j = 0; j < w; j++)
+            EXPECT_EQ(ft.get({i, j}), grid[i * w + j]);
+}
+
+TEST(FenwickTreeND, ThreeDimensionalBuildMatchesAdd)
+{
+    const std::array<std::size_t, 3> shape = {4, 5, 6};
+    std::vector<int> values(4 * 5 * 6);
+    for (std::size_t i = 0; i < values.size(); i++)
+        values[i] = static_cast<int>(i % 11);
+    gcl::FenwickTreeND<int, 3> built(shape, values), added(shape);
+    for (std::size_t i = 0; i < 4; i++)
+        for (std::size_t j = 0; j < 5; j++)
+            for (std::size_t k = 0; k < 6; k++)
+                added.add({i, j, k}, values[(i * 5 + j) * 6 + k]);
+    for (std::size_t i = 0; i <= 4; i++)
+        for (std::size_t j = 0; j <= 5; j++)
+            for (std::size_t k = 0; k <= 6; k++)
+                EXPECT_EQ(built.sum_prefix({i, j, k}), added.sum_prefix({i, j, k}));
+    EXPECT_EQ(built.sum({1, 2, 3}, {3, 4, 5}), added.sum({1, 2, 3}, {3, 4, 5}));
+}
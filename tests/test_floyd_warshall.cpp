@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../algorithm/floyd_warshall.hpp"
+#include "../algorithm/shortest_path.hpp"
+
+namespace
+{
+    // 重み`base + p[u] - p[v]`（`base >= 0`）の辺だけを持つ、負閉路の無い密なグラフ
+    template <typename W>
+    std::vector<W> random_matrix(std::size_t n, std::mt19937 &rng, gcl::WGraph<W> &g)
+    {
+        constexpr W INF = std::numeric_limits<W>::max();
+        std::vector<W> p(n);
+        for (auto &x : p)
+            x = static_cast<W>(rng() % 50);
+        std::vector<W> matrix(n * n, INF);
+        g.assign(n, {});
+        for (std::size_t u = 0; u < n; u++)
+        {
+            for (std::size_t v = 0; v < n; v++)
+            {
+                if (rng() % 3 == 0)
+                    continue;
+                const W w = static_cast<W>(rng() % 100) + p[u] - p[v];
+                matrix[u * n + v] = std::min(matrix[u * n + v], w);
+                g[u].push_back({v, w});
+            }
+        }
+        return matrix;
+    }
+}
+
+TEST(FloydWarshall, BlockedMatchesBellmanFord)
+{
+    using ll = long long;
+    std::mt19937 rng(3);
+    // タイルの端数や複数スレッドの組み合わせを試す
+    const std::vector<gcl::FloydWarshallOptions> options{{0, 1, false}, {4, 1, false}, {7, 3, false}, {16, 4, false}, {5, 2, true}};
+    for (const auto &opt : options)
+    {
+        const std::size_t N = 20 + rng() % 40;
+        gcl::WGraph<ll> g;
+        auto dist = random_matrix<ll>(N, rng, g);
+        auto res = gcl::floyd_warshall(dist, N, opt);
+        EXPECT_FALSE(res.negative_cycle_exist);
+        for (std::size_t u = 0; u < N; u++)
+        {
+            auto expected = gcl::bellman_ford(g, u).dist;
+            for (std::size_t v = 0; v < N; v++)
+                EXPECT_EQ(dist[u * N + v], expected[v]) << "block=" << opt.block << " u=" << u << " v=" << v;
+        }
+    }
+}
+
+TEST(FloydWarshall, Int32AndFloat)
+{
+    std::mt19937 rng(5);
+    const std::size_t N = 45;
+    gcl::WGraph<int> g;
+    auto dist = random_matrix<int>(N, rng, g);
+
+    std::vector<float> fdist(N * N);
+    for (std::size_t i = 0; i < N * N; i++)
+        fdist[i] = dist[i] == std::numeric_limits<int>::max() ? std::numeric_limits<float>::max() : static_cast<float>(dist[i]);
+
+    gcl::floyd_warshall(dist, N, {8, 2, false});
+    gcl::floyd_warshall(fdist, N, {8, 1, false});
+    for (std::size_t u = 0; u < N; u++)
+    {
+        auto expected = gcl::bellman_ford(g, u).dist;
+        for (std::size_t v = 0; v < N; v++)
+        {
+            EXPECT_EQ(dist[u * N + v], expected[v]);
+            EXPECT_EQ(fdist[u * N + v], static_cast<float>(expected[v]));
+        }
+    }
+}
+
+TEST(FloydWarshall, RestorePath)
+{
+    using ll = long long;
+    constexpr ll INF = std::numeric_limits<ll>::max();
+    const std::size_t N = 4;
+    std::vector<ll> dist(N * N, INF);
+    dist[0 * N + 1] = 1;
+    dist[1 * N + 2] = 1;
+    dist[0 * N + 2] = 5;
+    dist[2 * N + 3] = -1;
+
+    auto plain = dist;
+    EXPECT_TRUE(gcl::floyd_warshall(plain, N).next.empty());
+
+    auto res = gcl::floyd_warshall(dist, N, {.restore_path = true});
+    EXPECT_EQ(dist, plain);
+    EXPECT_EQ(dist[0 * N + 3], 1);
+    EXPECT_EQ(res.restore_path(0, 3), (std::vector<std::size_t>{0, 1, 2, 3}));
+    EXPECT_EQ(res.restore_path(2, 2), (std::vector<std::size_t>{2}));
+    EXPECT_TRUE(res.restore_path(3, 0).empty());
+    EXPECT_EQ(dist[3 * N + 0], INF);
+}
+
+TEST(FloydWarshall, DetectsNegativeCycle)
+{
+    using ll = long long;
+    constexpr ll INF = std::numeric_limits<ll>::max();
+    for (std::size_t block : {1, 2, 16})
+    {
+        std::vector<ll> dist{0, 2, INF,
+                             INF, 0, -1,
+                             INF, -2, 0};
+        EXPECT_TRUE(gcl::floyd_warshall(dist, 3, {.block = block}).negative_cycle_exist);
+    }
+}
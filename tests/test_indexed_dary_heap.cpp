@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <algorithm>
+#include "../data-structure/indexed_dary_heap.hpp"
+
+TEST(IndexedDaryHeap, PushPop)
+{
+    gcl::IndexedDaryHeap<int> heap(5);
+    EXPECT_TRUE(heap.empty());
+    heap.push(0, 7);
+    heap.push(3, 2);
+    heap.push(4, 5);
+    EXPECT_EQ(heap.size(), std::size_t{3});
+    EXPECT_EQ(heap.top(), std::size_t{3});
+    EXPECT_EQ(heap.top_key(), 2);
+    EXPECT_EQ(heap.pop(), (std::pair<int, std::size_t>{2, 3}));
+    EXPECT_EQ(heap.pop(), (std::pair<int, std::size_t>{5, 4}));
+    EXPECT_EQ(heap.pop(), (std::pair<int, std::size_t>{7, 0}));
+    EXPECT_TRUE(heap.empty());
+}
+
+TEST(IndexedDaryHeap, DecreaseKey)
+{
+    gcl::IndexedDaryHeap<int, 8> heap(4);
+    heap.push(0, 10);
+    heap.push(1, 20);
+    heap.push(2, 30);
+    heap.decrease_key(2, 5);
+    EXPECT_EQ(heap.key(2), 5);
+    EXPECT_EQ(heap.top(), std::size_t{2});
+
+    EXPECT_FALSE(heap.push_or_decrease(0, 15)); // 大きい鍵では変化しない
+    EXPECT_TRUE(heap.push_or_decrease(1, 1));
+    EXPECT_TRUE(heap.push_or_decrease(3, 7));
+    EXPECT_EQ(heap.size(), std::size_t{4});
+
+    std::vector<std::size_t> order;
+    while (!heap.empty())
+        order.push_back(heap.pop().second);
+    EXPECT_EQ(order, (std::vector<std::size_t>{1, 2, 3, 0}));
+}
+
+TEST(IndexedDaryHeap, ContainsAndClear)
+{
+    gcl::IndexedDaryHeap<long long> heap(3);
+    heap.push(1, 4);
+    EXPECT_TRUE(heap.contains(1));
+    EXPECT_FALSE(heap.contains(0));
+    heap.clear();
+    EXPECT_TRUE(heap.empty());
+    EXPECT_FALSE(heap.contains(1));
+    heap.push(1, 2); // clear 後に同じ番号を再び追加出来る
+    EXPECT_EQ(heap.top(), std::size_t{1});
+}
+
+TEST(IndexedDaryHeap, RandomOperationsSortKeys)
+{
+    constexpr std::size_t N = 1000;
+    std::mt19937 rng(42);
+    gcl::IndexedDaryHeap<unsigned, 4> heap(N);
+    std::vector<unsigned> best(N, std::numeric_limits<unsigned>::max());
+    for (std::size_t i = 0; i < 5 * N; i++)
+    {
+        auto id = rng() % N;
+        auto key = static_cast<unsigned>(rng() % 100000);
+        heap.push_or_decrease(id, key);
+        best[id] = std::min(best[id], key);
+    }
+
+    std::vector<unsigned> popped;
+    while (!heap.empty())
+    {
+        auto [key, id] = heap.pop();
+        EXPECT_EQ(key, best[id]);
+        popped.push_back(key);
+    }
+    EXPECT_TRUE(std::is_sorted(popped.begin(), popped.end()));
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+#include "../data-structure/lazy_segment_tree.hpp"
+
+namespace
+{
+    struct MinMonoid
+    {
+        using value_type = long long;
+        static value_type identity() { return std::numeric_limits<long long>::max(); }
+        static value_type op(value_type a, value_type b) { return std::min(a, b); }
+    };
+
+    // 区間代入
+    struct AssignAction
+    {
+        using value_type = std::optional<long long>;
+        static value_type identity() { return std::nullopt; }
+        static value_type op(const value_type &f, const value_type &g) { return f ? f : g; }
+        static long long act(const value_type &f, long long x) { return f ? *f : x; }
+    };
+
+    // 区間和（長さも持つ）
+    struct SumMonoid
+    {
+        struct value_type
+        {
+            long long sum = 0, len = 0;
+        };
+        static value_type identity() { return {}; }
+        static value_type op(const value_type &a, const value_type &b) { return {a.sum + b.sum, a.len + b.len}; }
+    };
+
+    // 区間への一次関数`x -> a * x + b`の作用
+    struct AffineAction
+    {
+        struct value_type
+        {
+            long long a = 1, b = 0;
+        };
+        static value_type identity() { return {}; }
+        static value_type op(const value_type &f, const value_type &g) { return {f.a * g.a, f.a * g.b + f.b}; }
+        static SumMonoid::value_type act(const value_type &f, const SumMonoid::value_type &x) { return {f.a * x.sum + f.b * x.len, x.len}; }
+    };
+}
+
+TEST(LazySegTree, RangeAssignRangeMin)
+{
+    std::vector<long long> naive(50);
+    for (std::size_t i = 0; i < naive.size(); i++)
+        naive[i] = static_cast<long long>((i * 31) % 23);
+    gcl::LazySegTree<MinMonoid, AssignAction> seg(naive);
+    std::mt19937 rng(12345);
+    for (int it = 0; it < 2000; it++)
+    {
+        std::size_t l = rng() % (naive.size() + 1), r = rng() % (naive.size() + 1);
+        if (l > r)
+            std::swap(l, r);
+        if (it % 3 == 0)
+        {
+            const auto val = static_cast<long long>(rng() % 100);
+            seg.apply(l, r, val);
+            std::fill(naive.begin() + static_cast<std::ptrdiff_t>(l), naive.begin() + static_cast<std::ptrdiff_t>(r), val);
+        }
+        else if (it % 3 == 1 && l < naive.size())
+        {
+            const auto val = static_cast<long long>(rng() % 100);
+            seg.set(l, val);
+            naive[l] = val;
+        }
+        const auto expected = l == r ? MinMonoid::identity() : *std::min_element(naive.begin() + static_cast<std::ptrdiff_t>(l), naive.begin() + static_cast<std::ptrdiff_t>(r));
+        EXPECT_EQ(seg.prod(l, r), expected);
+    }
+    for (std::size_t i = 0; i < naive.size(); i++)
+        EXPECT_EQ(seg.get(i), naive[i]);
+    EXPECT_EQ(seg.all_prod(), *std::min_element(naive.begin(), naive.end()));
+}
+
+TEST(LazySegTree, RangeAffineRangeSum)
+{
+    std::vector<long long> naive(33);
+    std::vector<SumMonoid::value_type> init;
+    for (std::size_t i = 0; i < naive.size(); i++)
+    {
+        naive[i] = static_cast<long long>(i % 5);
+        init.push_back({naive[i], 1});
+    }
+    gcl::LazySegTree<SumMonoid, AffineAction> seg(init);
+    std::mt19937 rng(12345);
+    for (int it = 0; it < 2000; it++)
+    {
+        std::size_t l = rng() % (naive.size() + 1), r = rng() % (naive.size() + 1);
+        if (l > r)
+            std::swap(l, r);
+        if (it % 2 == 0)
+        {
+            // 非負の値だけを保ち、`max_right`/`min_left`の条件が単調になるようにする
+            const long long a = static_cast<long long>(rng() % 2), b = static_cast<long long>(rng() % 4);
+            if (l < naive.size() && it % 4 == 0)
+            {
+                seg.apply(l, {a, b});
+                naive[l] = a * naive[l] + b;
+            }
+            else
+            {
+                seg.apply(l, r, {a, b});
+                for (auto i = l; i < r; i++)
+                    naive[i] = a * naive[i] + b;
+            }
+        }
+        long long expected = 0;
+        for (auto i = l; i < r; i++)
+            expected += naive[i];
+        EXPECT_EQ(seg.prod(l, r).sum, expected);
+
+        // 区間和が`limit`以下である最長の区間
+        const auto limit = static_cast<long long>(rng() % 40);
+        const auto pred = [&](const SumMonoid::value_type &s)
+        { return s.sum <= limit; };
+        auto expected_r = l;
+        long long acc = 0;
+        while (expected_r < naive.size() && acc + naive[expected_r] <= limit)
+            acc += naive[expected_r++];
+        EXPECT_EQ(seg.max_right(l, pred), expected_r);
+        auto expected_l = r;
+        acc = 0;
+        while (expected_l > 0 && acc + naive[expected_l - 1] <= limit)
+            acc += naive[--expected_l];
+        EXPECT_EQ(seg.min_left(r, pred), expected_l);
+    }
+}
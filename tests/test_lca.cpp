@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../algorithm/lca.hpp"
+
+namespace
+{
+    // 頂点`v`の親を`parent[v]`（`v > 0`で`parent[v] < v`）とするランダムな木
+    std::vector<std::size_t> random_parents(std::size_t n, std::mt19937 &rng)
+    {
+        std::vector<std::size_t> parent(n, 0);
+        for (std::size_t v = 1; v < n; v++)
+            parent[v] = rng() % v;
+        return parent;
+    }
+
+    std::size_t naive_lca(const std::vector<std::size_t> &parent, const std::vector<std::size_t> &depth, std::size_t u, std::size_t v)
+    {
+        while (depth[u] > depth[v])
+            u = parent[u];
+        while (depth[v] > depth[u])
+            v = parent[v];
+        while (u != v)
+        {
+            u = parent[u];
+            v = parent[v];
+        }
+        return u;
+    }
+}
+
+TEST(LCA, SmallTree)
+{
+    /*
+           0
+          / \
+         1   2
+        / \   \
+       3   4   5
+    */
+    gcl::Graph tree(6);
+    for (auto [u, v] : std::vector<std::pair<std::size_t, std::size_t>>{{0, 1}, {0, 2}, {1, 3}, {1, 4}, {2, 5}})
+    {
+        tree[u].emplace_back(v);
+        tree[v].emplace_back(u);
+    }
+    gcl::LCA lca(tree);
+    EXPECT_EQ(lca.lca(3, 4), 1u);
+    EXPECT_EQ(lca.lca(3, 5), 0u);
+    EXPECT_EQ(lca.lca(4, 1), 1u);
+    EXPECT_EQ(lca.lca(2, 2), 2u);
+    EXPECT_EQ(lca.distance(3, 5), 4u);
+    EXPECT_EQ(lca.depth(5), 2u);
+    EXPECT_EQ(lca.parent(0), 0u);
+    EXPECT_EQ(lca.parent(5), 2u);
+
+    // 根を変える
+    gcl::LCA rooted_at_3(tree, 3);
+    EXPECT_EQ(rooted_at_3.lca(4, 5), 1u);
+    EXPECT_EQ(rooted_at_3.lca(0, 2), 0u);
+}
+
+TEST(LCA, RandomTreeMatchesNaive)
+{
+    const std::size_t n = 2000;
+    std::mt19937 rng(12345);
+    const auto parent = random_parents(n, rng);
+    std::vector<std::size_t> depth(n, 0);
+    gcl::Graph tree(n);
+    for (std::size_t v = 1; v < n; v++)
+    {
+        depth[v] = depth[parent[v]] + 1;
+        tree[v].emplace_back(parent[v]);
+        tree[parent[v]].emplace_back(v);
+    }
+    gcl::LCA lca(tree);
+    std::vector<std::pair<std::size_t, std::size_t>> queries;
+    for (int i = 0; i < 5000; i++)
+        queries.emplace_back(rng() % n, rng() % n);
+
+    const auto batch = lca.lca(queries, 3);
+    const auto dists = lca.distance(queries, 2);
+    for (std::size_t i = 0; i < queries.size(); i++)
+    {
+        const auto [u, v] = queries[i];
+        const auto expected = naive_lca(parent, depth, u, v);
+        EXPECT_EQ(lca.lca(u, v), expected);
+        EXPECT_EQ(batch[i], expected);
+        EXPECT_EQ(dists[i], depth[u] + depth[v] - 2 * depth[expected]);
+    }
+}
+
+TEST(LCA, WeightedDistance)
+{
+    const std::size_t n = 500;
+    std::mt19937 rng(12345);
+    const auto parent = random_parents(n, rng);
+    std::vector<long long> dist(n, 0);
+    std::vector<std::size_t> depth(n, 0);
+    gcl::WGraph<long long> tree(n);
+    for (std::size_t v = 1; v < n; v++)
+    {
+        const auto w = static_cast<long long>(rng() % 100);
+        dist[v] = dist[parent[v]] + w;
+        depth[v] = depth[parent[v]] + 1;
+        tree[v].emplace_back(parent[v], w);
+        tree[parent[v]].emplace_back(v, w);
+    }
+    gcl::LCA lca(tree);
+    static_assert(std::is_same_v<decltype(lca)::weight_type, long long>);
+    for (int i = 0; i < 2000; i++)
+    {
+        const auto u = rng() % n, v = rng() % n;
+        const auto a = naive_lca(parent, depth, u, v);
+        EXPECT_EQ(lca.lca(u, v), a);
+        EXPECT_EQ(lca.distance(u, v), dist[u] + dist[v] - 2 * dist[a]);
+        EXPECT_EQ(lca.dist(u), dist[u]);
+    }
+}
@@ -1,6 +1,42 @@
 #include <gtest/gtest.h>
+#include <random>
+#include <tuple>
 #include "../algorithm/minimum_spanning_tree.hpp"
 
+namespace
+{
+    template <class W>
+    std::vector<std::tuple<std::size_t, std::size_t, W>> as_tuples(const std::vector<gcl::UWEdge<W>> &edges)
+    {
+        std::vector<std::tuple<std::size_t, std::size_t, W>> result;
+        for (const auto &e : edges)
+            result.emplace_back(e.from, e.to, e.weight);
+        return result;
+    }
+
+    // `kruskal`と結果（採用した辺の順序まで）が一致するか確かめる
+    template <class W>
+    void expect_same_result(const gcl::KruskalResult<W> &actual, const gcl::KruskalResult<W> &expected)
+    {
+        EXPECT_EQ(actual.total_weight, expected.total_weight);
+        EXPECT_EQ(actual.is_connected, expected.is_connected);
+        EXPECT_EQ(as_tuples(actual.edges), as_tuples(expected.edges));
+    }
+
+    // 重みの種類が少なく同点が多い、ランダムな辺集合（同じ辺の重複や自己ループも含む）
+    template <class W>
+    std::vector<gcl::UWEdge<W>> random_edges(std::size_t n, std::size_t m, W lo, W hi, std::mt19937 &rng)
+    {
+        std::uniform_int_distribution<W> weight(lo, hi);
+        std::vector<gcl::UWEdge<W>> edges;
+        for (std::size_t i = 0; i < m; i++)
+            edges.emplace_back(rng() % n, rng() % n, weight(rng));
+        for (std::size_t i = 0; i < m / 10; i++)
+            edges.push_back(edges[rng() % edges.size()]);
+        return edges;
+    }
+}
+
 TEST(MinimumSpanningTree, KruskalEdgeListConnected)
 {
     using W = long long;
@@ -88,3 +124,206 @@ TEST(MinimumSpanningTree, KruskalDisconnectedGivesForest)
         deg_sum += adj.size();
     EXPECT_EQ(deg_sum, 4u); // 2*2本
 }
+
+TEST(MinimumSpanningTree, FilterAndRadixKruskalMatchKruskal)
+{
+    std::mt19937 rng(9);
+    for (auto [n, m] : std::vector<std::pair<std::size_t, std::size_t>>{{1, 0}, {5, 3}, {300, 200}, {2000, 20000}, {5000, 60000}})
+    {
+        auto signed_edges = random_edges<long long>(n, m, -50, 50, rng);
+        auto expected = gcl::kruskal(n, signed_edges);
+        expect_same_result(gcl::filter_kruskal(n, signed_edges), expected);
+        expect_same_result(gcl::radix_kruskal(n, signed_edges), expected);
+
+        auto unsigned_edges = random_edges<std::uint32_t>(n, m, 0, 1u << 20, rng);
+        auto expected_u = gcl::kruskal(n, unsigned_edges);
+        expect_same_result(gcl::filter_kruskal(n, unsigned_edges), expected_u);
+        expect_same_result(gcl::radix_kruskal(n, unsigned_edges), expected_u);
+    }
+}
+
+TEST(MinimumSpanningTree, FilterAndRadixKruskalOnWGraph)
+{
+    using W = int;
+    std::mt19937 rng(4);
+    const std::size_t n = 3000;
+    gcl::WGraph<W> g(n);
+    for (std::size_t i = 0; i < 4 * n; i++)
+    {
+        std::size_t u = rng() % n, v = rng() % n;
+        W w = static_cast<W>(rng() % 100) - 20;
+        g[u].emplace_back(v, w);
+        g[v].emplace_back(u, w);
+    }
+    auto expected = gcl::kruskal(g);
+    expect_same_result(gcl::filter_kruskal(g), expected);
+    expect_same_result(gcl::radix_kruskal(g), expected);
+
+    // 浮動小数点数の重みでも Filter-Kruskal は使える
+    gcl::WGraph<double> gd(3);
+    gd[0].emplace_back(1, 0.5);
+    gd[1].emplace_back(0, 0.5);
+    gd[1].emplace_back(2, 0.25);
+    gd[2].emplace_back(1, 0.25);
+    EXPECT_DOUBLE_EQ(gcl::filter_kruskal(gd).total_weight, 0.75);
+}
+
+TEST(MinimumSpanningTree, BoruvkaMatchesKruskal)
+{
+    std::mt19937 rng(12);
+    for (auto [n, m] : std::vector<std::pair<std::size_t, std::size_t>>{{0, 0}, {1, 0}, {6, 4}, {400, 300}, {3000, 20000}})
+    {
+        auto edges = random_edges<long long>(std::max<std::size_t>(n, 1), m, -30, 30, rng);
+        auto expected = gcl::kruskal(n, edges);
+        for (std::size_t threads : {1, 2, 5})
+            expect_same_result(gcl::boruvka(n, edges, threads), expected);
+    }
+
+    // 浮動小数点数の重みでも、足す順序まで揃えているので総和が完全に一致する
+    std::vector<gcl::UWEdge<double>> edges;
+    for (std::size_t i = 0; i < 5000; i++)
+        edges.emplace_back(rng() % 1000, rng() % 1000, std::uniform_real_distribution<double>(0, 1)(rng));
+    auto expected = gcl::kruskal(1000, edges);
+    auto actual = gcl::boruvka(1000, edges, 4);
+    EXPECT_EQ(actual.total_weight, expected.total_weight);
+    EXPECT_EQ(as_tuples(actual.edges), as_tuples(expected.edges));
+}
+
+TEST(MinimumSpanningTree, BoruvkaOnWGraph)
+{
+    gcl::WGraph<int> g(5);
+    auto add_undirected = [&](std::size_t u, std::size_t v, int w)
+    {
+        g[u].emplace_back(v, w);
+        g[v].emplace_back(u, w);
+    };
+    add_undirected(0, 1, 1);
+    add_undirected(1, 2, 1);
+    add_undirected(0, 2, 1);
+    add_undirected(3, 4, 7);
+
+    auto res = gcl::boruvka(g, 3);
+    expect_same_result(res, gcl::kruskal(g));
+    EXPECT_FALSE(res.is_connected);
+    EXPECT_EQ(res.total_weight, 9);
+}
+
+TEST(MinimumSpanningTree, PrimMatchesKruskal)
+{
+    std::mt19937 rng(21);
+    for (std::size_t n : {1, 2, 50, 400})
+    {
+        // 重みが全て異なれば最小全域木は一意なので、辺集合まで一致する
+        std::vector<long long> w(n * n);
+        std::vector<long long> pool(n * n);
+        for (std::size_t i = 0; i < n * n; i++)
+            pool[i] = static_cast<long long>(i) - static_cast<long long>(n);
+        std::shuffle(pool.begin(), pool.end(), rng);
+        std::vector<gcl::UWEdge<long long>> complete;
+        gcl::WGraph<long long> g(n);
+        for (std::size_t u = 0; u < n; u++)
+        {
+            for (std::size_t v = u + 1; v < n; v++)
+            {
+                w[u * n + v] = w[v * n + u] = pool[u * n + v];
+                complete.emplace_back(u, v, pool[u * n + v]);
+                // 疎なグラフ版は一部の辺だけ使う
+                if (rng() % 8 == 0 || v == u + 1)
+                {
+                    g[u].emplace_back(v, pool[u * n + v]);
+                    g[v].emplace_back(u, pool[u * n + v]);
+                }
+            }
+        }
+        auto dense = gcl::prim_dense(n, [&](std::size_t u, std::size_t v)
+                                     { return w[u * n + v]; });
+        expect_same_result(dense, gcl::kruskal(n, complete));
+        expect_same_result(gcl::prim(g), gcl::kruskal(g));
+    }
+}
+
+TEST(MinimumSpanningTree, PrimWithTiesAndForest)
+{
+    std::mt19937 rng(5);
+    const std::size_t n = 300;
+    gcl::WGraph<int> g(n);
+    for (std::size_t i = 0; i < 3 * n; i++)
+    {
+        // 頂点 0..149 と 150..299 の間には辺を張らない
+        std::size_t u = rng() % (n / 2), v = rng() % (n / 2);
+        if (i % 2)
+            u += n / 2, v += n / 2;
+        int w = static_cast<int>(rng() % 5);
+        g[u].emplace_back(v, w);
+        g[v].emplace_back(u, w);
+    }
+    auto expected = gcl::kruskal(g);
+    auto actual = gcl::prim(g);
+    EXPECT_EQ(actual.total_weight, expected.total_weight);
+    EXPECT_EQ(actual.edges.size(), expected.edges.size());
+    EXPECT_FALSE(actual.is_connected);
+    for (const auto &e : actual.edges)
+        EXPECT_LT(e.from, e.to);
+
+    // 距離関数で与える点集合（max を返すペアは辺が無い）
+    std::vector<std::pair<int, int>> points{{0, 0}, {3, 4}, {6, 8}, {100, 100}};
+    auto res = gcl::prim_dense(points.size(), [&](std::size_t a, std::size_t b)
+                               {
+                                   if ((a == 3) != (b == 3))
+                                       return std::numeric_limits<long long>::max();
+                                   long long dx = points[a].first - points[b].first, dy = points[a].second - points[b].second;
+                                   return dx * dx + dy * dy; });
+    EXPECT_EQ(res.total_weight, 50);
+    EXPECT_FALSE(res.is_connected);
+}
+
+TEST(MinimumSpanningTree, KruskalInplaceEdgeList)
+{
+    std::mt19937 rng(30);
+    auto edges = random_edges<long long>(500, 3000, -100, 100, rng);
+    auto expected = gcl::kruskal(500, edges);
+
+    auto res = gcl::kruskal_inplace(500, edges);
+    EXPECT_TRUE(std::is_sorted(edges.begin(), edges.end(), [](const auto &a, const auto &b)
+                               { return std::tuple(a.weight, a.from, a.to) < std::tuple(b.weight, b.from, b.to); }));
+    EXPECT_EQ(res.total_weight, expected.total_weight);
+    EXPECT_EQ(res.is_connected, expected.is_connected);
+    std::vector<gcl::UWEdge<long long>> taken;
+    for (auto id : res.edge_ids)
+        taken.push_back(edges[id]);
+    EXPECT_EQ(as_tuples(taken), as_tuples(expected.edges));
+
+    auto csr = gcl::build_mst_csr(500, edges, res);
+    EXPECT_EQ(csr.num_edges(), 2 * res.edge_ids.size());
+    auto csr2 = expected.build_mst_csr(500);
+    EXPECT_EQ(csr2.num_edges(), csr.num_edges());
+}
+
+TEST(MinimumSpanningTree, KruskalInplaceCSR)
+{
+    std::mt19937 rng(31);
+    const std::size_t n = 800;
+    auto edges = random_edges<int>(n, 6000, -1000, 1000, rng);
+    gcl::CSRGraph<int> g(n, edges, true);
+
+    // 重みが全て異なるとは限らないので、重みの総和と辺の本数を比べる
+    auto expected = gcl::kruskal(g);
+    std::vector<std::uint32_t> order32(g.num_edges() / 2);
+    std::vector<std::uint64_t> order64(g.num_edges() / 2);
+    auto by_index = gcl::kruskal_inplace(g, std::span(order32));
+    auto by_key = gcl::kruskal_inplace(g, std::span(order64));
+    auto allocated = gcl::kruskal_inplace(g);
+    for (const auto *res : {&by_index, &by_key, &allocated})
+    {
+        EXPECT_EQ(res->total_weight, expected.total_weight);
+        EXPECT_EQ(res->edge_ids.size(), expected.edges.size());
+        EXPECT_EQ(res->is_connected, expected.is_connected);
+    }
+    // 詰めたキーでも (重み, 辺番号) の順は同じ
+    EXPECT_EQ(by_index.edge_ids, by_key.edge_ids);
+
+    auto tree = gcl::build_mst_csr(g, by_index);
+    EXPECT_EQ(tree.size(), n);
+    EXPECT_EQ(tree.num_edges(), 2 * by_index.edge_ids.size());
+    EXPECT_EQ(gcl::kruskal(tree).total_weight, expected.total_weight);
+}
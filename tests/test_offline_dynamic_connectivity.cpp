@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include "../algorithm/offline_dynamic_connectivity.hpp"
+
+TEST(OfflineDynamicConnectivity, Small)
+{
+    gcl::OfflineDynamicConnectivity dc(4);
+    dc.add_edge(0, 1);
+    auto q0 = dc.same(0, 1);
+    dc.add_edge(2, 1);
+    auto q1 = dc.same(0, 2);
+    dc.remove_edge(1, 0);
+    auto q2 = dc.same(0, 2);
+    auto q3 = dc.same(1, 2);
+    dc.add_edge(0, 1);
+    dc.add_edge(0, 1); // 多重辺
+    dc.remove_edge(0, 1);
+    auto q4 = dc.same(0, 2);
+    auto q5 = dc.same(3, 3);
+
+    auto ans = dc.solve();
+    ASSERT_EQ(ans.size(), std::size_t{6});
+    EXPECT_TRUE(ans[q0]);
+    EXPECT_TRUE(ans[q1]);
+    EXPECT_FALSE(ans[q2]);
+    EXPECT_TRUE(ans[q3]);
+    EXPECT_TRUE(ans[q4]);
+    EXPECT_TRUE(ans[q5]);
+}
+
+TEST(OfflineDynamicConnectivity, MatchesRebuild)
+{
+    const std::size_t N = 12;
+    std::mt19937 rng(2);
+    gcl::OfflineDynamicConnectivity dc(N);
+    std::multiset<std::pair<std::size_t, std::size_t>> edges;
+    std::vector<bool> expected;
+    for (int step = 0; step < 2000; step++)
+    {
+        const auto kind = rng() % 3;
+        std::size_t u = rng() % N, v = rng() % N;
+        if (kind == 0)
+        {
+            dc.add_edge(u, v);
+            edges.insert(std::minmax(u, v));
+        }
+        else if (kind == 1 && !edges.empty())
+        {
+            auto it = std::next(edges.begin(), rng() % edges.size());
+            // 逆向きで指定しても同じ辺として扱われる
+            dc.remove_edge(it->second, it->first);
+            edges.erase(it);
+        }
+        else
+        {
+            dc.same(u, v);
+            gcl::UnionFind uf(N);
+            for (auto [a, b] : edges)
+                uf.unite(a, b);
+            expected.push_back(uf.same(u, v));
+        }
+    }
+    EXPECT_EQ(dc.solve(), expected);
+}
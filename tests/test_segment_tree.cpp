@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "../data-structure/segment_tree.hpp"
+
+namespace
+{
+    struct MinMonoid
+    {
+        using value_type = int;
+        static value_type identity() { return std::numeric_limits<int>::max(); }
+        static value_type op(value_type a, value_type b) { return std::min(a, b); }
+    };
+
+    struct SumMonoid
+    {
+        using value_type = long long;
+        static value_type identity() { return 0; }
+        static value_type op(value_type a, value_type b) { return a + b; }
+    };
+
+    // 非可換なモノイド（文字列の連結）
+    struct ConcatMonoid
+    {
+        using value_type = std::string;
+        static value_type identity() { return ""; }
+        static value_type op(const value_type &a, const value_type &b) { return a + b; }
+    };
+}
+
+TEST(SegTree, ProdAndSet)
+{
+    gcl::SegTree<MinMonoid> seg(std::vector<int>{5, 3, 8, 1, 9});
+    EXPECT_EQ(seg.size(), 5u);
+    EXPECT_EQ(seg.prod(0, 5), 1);
+    EXPECT_EQ(seg.prod(0, 3), 3);
+    EXPECT_EQ(seg.prod(4, 5), 9);
+    EXPECT_EQ(seg.prod(2, 2), MinMonoid::identity());
+    seg.set(3, 10);
+    EXPECT_EQ(seg.get(3), 10);
+    EXPECT_EQ(seg.all_prod(), 3);
+}
+
+TEST(SegTree, NonCommutative)
+{
+    gcl::SegTree<ConcatMonoid> seg(std::vector<std::string>{"a", "b", "c", "d", "e", "f", "g"});
+    EXPECT_EQ(seg.prod(1, 6), "bcdef");
+    seg.set(3, "X");
+    EXPECT_EQ(seg.prod(0, 7), "abcXefg");
+    EXPECT_EQ(seg.all_prod(), "abcXefg");
+}
+
+TEST(SegTree, MaxRightMinLeftMatchNaive)
+{
+    std::vector<long long> naive(37);
+    for (std::size_t i = 0; i < naive.size(); i++)
+        naive[i] = static_cast<long long>((i * 17) % 10);
+    gcl::SegTree<SumMonoid> seg(naive);
+    std::mt19937 rng(12345);
+    for (int it = 0; it < 1000; it++)
+    {
+        const auto pos = rng() % naive.size();
+        const auto val = static_cast<long long>(rng() % 10);
+        seg.set(pos, val);
+        naive[pos] = val;
+
+        const auto limit = static_cast<long long>(rng() % 100);
+        const auto pred = [&](long long s)
+        { return s <= limit; };
+        const auto l = rng() % (naive.size() + 1);
+        auto expected_r = l;
+        long long acc = 0;
+        while (expected_r < naive.size() && acc + naive[expected_r] <= limit)
+            acc += naive[expected_r++];
+        EXPECT_EQ(seg.max_right(l, pred), expected_r);
+
+        const auto r = rng() % (naive.size() + 1);
+        auto expected_l = r;
+        acc = 0;
+        while (expected_l > 0 && acc + naive[expected_l - 1] <= limit)
+            acc += naive[--expected_l];
+        EXPECT_EQ(seg.min_left(r, pred), expected_l);
+    }
+}
+
+TEST(SegTree, Empty)
+{
+    gcl::SegTree<SumMonoid> seg(0);
+    EXPECT_EQ(seg.size(), 0u);
+    EXPECT_EQ(seg.prod(0, 0), 0);
+    EXPECT_EQ(seg.max_right(0, [](long long)
+                            { return true; }),
+              0u);
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
+#include <random>
+#include <optional>
 #include "../algorithm/shortest_path.hpp"
 #include "../data-structure/graph.hpp"
+#include "../data-structure/csr_graph.hpp"
 
 using ull = std::uint64_t;
 
@@ -62,6 +65,299 @@ TEST(Dijkstra, Unreachable)
     EXPECT_EQ(dist[3], INF);
 }
 
+TEST(DijkstraQueue, RadixHeapPopsInOrder)
+{
+    gcl::RadixHeapQueue<ull> q;
+    q.push(5, 0);
+    q.push(3, 1);
+    q.push(9, 2);
+    EXPECT_EQ(q.pop(), (std::pair<ull, std::size_t>{3, 1}));
+    q.push(4, 3);
+    EXPECT_EQ(q.pop(), (std::pair<ull, std::size_t>{4, 3}));
+    EXPECT_EQ(q.pop(), (std::pair<ull, std::size_t>{5, 0}));
+    EXPECT_EQ(q.pop(), (std::pair<ull, std::size_t>{9, 2}));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(DijkstraQueue, DialPopsInOrder)
+{
+    gcl::DialQueue<int> q(4);
+    q.push(0, 0);
+    q.push(3, 1);
+    q.push(2, 2);
+    EXPECT_EQ(q.pop(), (std::pair<int, std::size_t>{0, 0}));
+    EXPECT_EQ(q.pop(), (std::pair<int, std::size_t>{2, 2}));
+    q.push(6, 3);
+    EXPECT_EQ(q.pop(), (std::pair<int, std::size_t>{3, 1}));
+    EXPECT_EQ(q.pop(), (std::pair<int, std::size_t>{6, 3}));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(DijkstraQueue, DefaultQueueSelection)
+{
+    static_assert(std::same_as<gcl::default_dijkstra_queue_t<ull>, gcl::RadixHeapQueue<ull>>);
+    static_assert(std::same_as<gcl::default_dijkstra_queue_t<int>, gcl::RadixHeapQueue<int>>);
+    static_assert(std::same_as<gcl::default_dijkstra_queue_t<double>, gcl::BinaryHeapQueue<double>>);
+}
+
+TEST(DijkstraQueue, AllQueuesAgreeOnRandomGraph)
+{
+    constexpr std::size_t N = 300;
+    constexpr ull MAX_W = 20;
+    std::mt19937 rng(12345);
+    gcl::WGraph<ull> g(N);
+    for (std::size_t i = 0; i < 3000; i++)
+        g[rng() % N].push_back({rng() % N, rng() % (MAX_W + 1)});
+
+    auto expected = gcl::dijkstra_dist(g, 0, gcl::BinaryHeapQueue<ull>{});
+    EXPECT_EQ(gcl::dijkstra_dist(g, 0), expected);
+    EXPECT_EQ(gcl::dijkstra_dist(g, 0, gcl::RadixHeapQueue<ull>{}), expected);
+    EXPECT_EQ(gcl::dijkstra_dist(g, 0, gcl::DialQueue<ull>(MAX_W)), expected);
+    EXPECT_EQ(gcl::dijkstra_dist(g, 0, gcl::IndexedHeapQueue<ull>(N)), expected);
+    EXPECT_EQ((gcl::dijkstra_dist(g, 0, gcl::IndexedHeapQueue<ull, 8>(N))), expected);
+
+    auto res = gcl::dijkstra_path(g, 0, gcl::DialQueue<ull>(MAX_W));
+    EXPECT_EQ(res.dist, expected);
+    for (std::size_t v = 0; v < N; v++)
+    {
+        if (expected[v] == std::numeric_limits<ull>::max())
+            continue;
+        auto path = res.restore_path(v);
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(path.front(), 0u);
+        EXPECT_EQ(path.back(), v);
+    }
+}
+
+// `path`が`graph`上の辺をたどる経路であれば、その重みの総和を返す
+template <class G>
+std::optional<ull> path_weight(const G &graph, const std::vector<std::size_t> &path)
+{
+    ull total = 0;
+    for (std::size_t i = 0; i + 1 < path.size(); i++)
+    {
+        std::optional<ull> best;
+        for (const auto &e : graph[path[i]])
+        {
+            if (e.to == path[i + 1] && (!best || e.weight < *best))
+                best = e.weight;
+        }
+        if (!best)
+            return std::nullopt;
+        total += *best;
+    }
+    return total;
+}
+
+TEST(DijkstraST, StopsAtGoal)
+{
+    gcl::WGraph<ull> g(4);
+    g[0].push_back({1, 1});
+    g[1].push_back({2, 1});
+    g[2].push_back({3, 1});
+
+    auto res = gcl::dijkstra_st(g, 0, 1);
+    EXPECT_EQ(res.dist[1], 1u);
+    EXPECT_EQ(res.restore_path(1), (std::vector<std::size_t>{0, 1}));
+    EXPECT_EQ(res.dist[3], std::numeric_limits<ull>::max()); // 1 を確定させた時点で打ち切る
+}
+
+TEST(BidirectionalDijkstra, SimpleLine)
+{
+    gcl::WGraph<ull> g(4), rg(4);
+    auto add = [&](std::size_t u, std::size_t v, ull w)
+    {
+        g[u].push_back({v, w});
+        rg[v].push_back({u, w});
+    };
+    add(0, 1, 5);
+    add(1, 2, 6);
+    add(2, 3, 9);
+    add(0, 3, 30);
+
+    auto res = gcl::bidirectional_dijkstra(g, rg, 0, 3);
+    EXPECT_EQ(res.dist[3], 20u);
+    EXPECT_EQ(res.restore_path(3), (std::vector<std::size_t>{0, 1, 2, 3}));
+
+    auto same = gcl::bidirectional_dijkstra(g, rg, 2, 2);
+    EXPECT_EQ(same.dist[2], 0u);
+    EXPECT_EQ(same.restore_path(2), (std::vector<std::size_t>{2}));
+
+    auto unreachable = gcl::bidirectional_dijkstra(g, rg, 3, 0);
+    EXPECT_EQ(unreachable.dist[0], std::numeric_limits<ull>::max());
+    EXPECT_TRUE(unreachable.restore_path(0).empty());
+}
+
+TEST(PointToPoint, MatchesFullDijkstraOnRandomGraphs)
+{
+    constexpr ull INF = std::numeric_limits<ull>::max();
+    std::mt19937 rng(2024);
+    for (int iter = 0; iter < 20; iter++)
+    {
+        const std::size_t N = 50 + rng() % 50;
+        gcl::WGraph<ull> g(N), rg(N);
+        for (std::size_t i = 0; i < 4 * N; i++)
+        {
+            std::size_t u = rng() % N, v = rng() % N;
+            ull w = rng() % 10; // 重み0の辺も含める
+            g[u].push_back({v, w});
+            rg[v].push_back({u, w});
+        }
+        gcl::CSRGraph<ull> csr(g), rcsr(rg);
+
+        for (int q = 0; q < 10; q++)
+        {
+            std::size_t s = rng() % N, t = rng() % N;
+            auto expected = gcl::dijkstra_dist(g, s)[t];
+
+            auto st = gcl::dijkstra_st(g, s, t);
+            EXPECT_EQ(st.dist[t], expected);
+
+            auto bi = gcl::bidirectional_dijkstra(csr, rcsr, s, t, gcl::IndexedHeapQueue<ull>(N));
+            EXPECT_EQ(bi.dist[t], expected);
+            if (expected == INF)
+            {
+                EXPECT_TRUE(bi.restore_path(t).empty());
+                continue;
+            }
+            auto path = bi.restore_path(t);
+            ASSERT_FALSE(path.empty());
+            EXPECT_EQ(path.front(), s);
+            EXPECT_EQ(path.back(), t);
+            EXPECT_EQ(path_weight(g, path), std::optional<ull>{expected});
+            EXPECT_EQ(path_weight(g, st.restore_path(t)), std::optional<ull>{expected});
+        }
+    }
+}
+
+TEST(DijkstraWorkspace, ReuseMatchesFreshRuns)
+{
+    std::mt19937 rng(7);
+    constexpr std::size_t N = 200;
+    gcl::WGraph<ull> g(N);
+    for (std::size_t i = 0; i < 1000; i++)
+        g[rng() % N].push_back({rng() % N, rng() % 100});
+
+    gcl::DijkstraWorkspace<ull> ws(N);
+    for (std::size_t s = 0; s < N; s += 17)
+    {
+        const auto &dist = gcl::dijkstra_dist(g, s, ws);
+        EXPECT_EQ(dist, gcl::dijkstra_dist(g, s));
+
+        const auto &res = gcl::dijkstra_path(g, s, ws);
+        auto fresh = gcl::dijkstra_path(g, s);
+        EXPECT_EQ(res.start(), s);
+        for (std::size_t v = 0; v < N; v += 11)
+            EXPECT_EQ(res.restore_path(v), fresh.restore_path(v));
+    }
+}
+
+TEST(DijkstraWorkspace, ResetsOnlyTouchedVertices)
+{
+    constexpr ull INF = std::numeric_limits<ull>::max();
+    gcl::WGraph<ull> g(6);
+    g[0].push_back({1, 1});
+    g[1].push_back({2, 1});
+    g[3].push_back({4, 1});
+    g[4].push_back({5, 1});
+
+    gcl::DijkstraWorkspace<ull, gcl::IndexedHeapQueue<ull>> ws(6, gcl::IndexedHeapQueue<ull>(6));
+    gcl::dijkstra_dist(g, 0, ws);
+    EXPECT_EQ(ws.touched().size(), std::size_t{3});
+
+    const auto &dist = gcl::dijkstra_dist(g, 3, ws);
+    EXPECT_EQ(dist, (std::vector<ull>{INF, INF, INF, 0, 1, 2}));
+
+    const auto &st = gcl::dijkstra_st(g, 3, 4, ws);
+    EXPECT_EQ(st.dist()[4], 1u);
+    EXPECT_EQ(st.restore_path(4), (std::vector<std::size_t>{3, 4}));
+}
+
+TEST(DijkstraMany, MatrixMatchesSerialRuns)
+{
+    std::mt19937 rng(99);
+    constexpr std::size_t N = 150;
+    gcl::WGraph<ull> g(N);
+    for (std::size_t i = 0; i < 800; i++)
+        g[rng() % N].push_back({rng() % N, rng() % 50});
+
+    std::vector<std::size_t> sources;
+    for (std::size_t s = 0; s < N; s += 3)
+        sources.push_back(s);
+
+    for (std::size_t threads : {1, 4})
+    {
+        std::vector<ull> matrix(sources.size() * N);
+        gcl::dijkstra_many(g, sources, matrix, threads);
+        for (std::size_t i = 0; i < sources.size(); i++)
+        {
+            auto expected = gcl::dijkstra_dist(g, sources[i]);
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), matrix.begin() + i * N));
+        }
+    }
+}
+
+TEST(DijkstraMany, CallbackReceivesEverySource)
+{
+    gcl::WGraph<ull> g(3);
+    g[0].push_back({1, 2});
+    g[1].push_back({2, 3});
+
+    std::vector<std::size_t> sources{0, 1, 2, 0};
+    std::vector<ull> to_2(sources.size());
+    gcl::dijkstra_many(
+        g, sources, [&](std::size_t i, const std::vector<ull> &dist)
+        { to_2[i] = dist[2]; }, 3);
+    EXPECT_EQ(to_2, (std::vector<ull>{5, 3, 0, 5}));
+}
+
+TEST(DeltaStepping, MatchesDijkstraExactly)
+{
+    std::mt19937 rng(31415);
+    for (int iter = 0; iter < 10; iter++)
+    {
+        const std::size_t N = 500 + rng() % 3000;
+        gcl::WGraph<ull> g(N);
+        for (std::size_t i = 0; i < 6 * N; i++)
+            g[rng() % N].push_back({rng() % N, rng() % 1000});
+        gcl::CSRGraph<ull> csr(g);
+
+        const std::size_t s = rng() % N;
+        const auto expected = gcl::dijkstra_dist(g, s);
+        for (ull delta : {1ull, 37ull, 250ull, 5000ull})
+        {
+            EXPECT_EQ(gcl::delta_stepping(g, s, delta, 1), expected);
+            EXPECT_EQ(gcl::delta_stepping(csr, s, delta, 4), expected);
+        }
+    }
+}
+
+TEST(DeltaStepping, ManyLargeBucketsReuseWorkers)
+{
+    // 並列に処理される大きなバケットが多数続く場合（ワーカーは全体で1組だけ作られる）
+    std::mt19937 rng(2718);
+    const std::size_t N = 20000;
+    gcl::WGraph<ull> g(N);
+    for (std::size_t i = 0; i < 8 * N; i++)
+        g[rng() % N].push_back({rng() % N, 1 + rng() % 100});
+    const auto expected = gcl::dijkstra_dist(g, 0);
+    EXPECT_EQ(gcl::delta_stepping(g, 0, 3, 4), expected);
+    EXPECT_EQ(gcl::delta_stepping(g, 0, 40, 3), expected);
+}
+
+TEST(DeltaStepping, FloatingWeightsAndUnreachable)
+{
+    gcl::WGraph<double> g(5);
+    g[0].push_back({1, 0.5});
+    g[1].push_back({2, 2.25});
+    g[0].push_back({2, 3.0});
+    g[2].push_back({3, 0.0});
+
+    auto dist = gcl::delta_stepping(g, 0, 1.0, 2);
+    EXPECT_EQ(dist, gcl::dijkstra_dist(g, 0));
+    EXPECT_EQ(dist[4], std::numeric_limits<double>::max());
+}
+
 TEST(BellmanFord, SimpleGraphNoNegativeCycle)
 {
     using ll = long long;
@@ -123,3 +419,189 @@ TEST(BellmanFord, NegativeCycleUnreachable)
     EXPECT_EQ(res.dist[3], INF);
     EXPECT_EQ(res.dist[4], INF);
 }
+
+// 負閉路から到達可能な頂点を負の無限大とする素朴な Bellman-Ford 法
+std::vector<long long> naive_bellman_ford_with_neg_inf(const gcl::WGraph<long long> &g, std::size_t s)
+{
+    constexpr long long INF = std::numeric_limits<long long>::max();
+    constexpr long long NEG_INF = std::numeric_limits<long long>::lowest();
+    const auto N = g.size();
+    std::vector<long long> dist(N, INF);
+    dist[s] = 0;
+    for (std::size_t iter = 0; iter < 2 * N; iter++)
+    {
+        for (std::size_t u = 0; u < N; u++)
+        {
+            if (dist[u] == INF)
+                continue;
+            for (const auto &e : g[u])
+            {
+                long long nd = dist[u] == NEG_INF ? NEG_INF : dist[u] + e.weight;
+                if (nd < dist[e.to])
+                    dist[e.to] = iter >= N - 1 ? NEG_INF : nd;
+            }
+        }
+    }
+    return dist;
+}
+
+TEST(SPFA, MatchesBellmanFordWithoutNegativeCycle)
+{
+    using ll = long long;
+    std::mt19937 rng(5);
+    constexpr std::size_t N = 120;
+    gcl::WGraph<ll> g(N);
+    // 頂点番号が減る向きの辺を十分重くするので負閉路は無い
+    for (std::size_t i = 0; i < 600; i++)
+    {
+        std::size_t u = rng() % N, v = rng() % N;
+        if (u < v)
+            g[u].push_back({v, static_cast<ll>(rng() % 40) - 20});
+        else
+            g[u].push_back({v, static_cast<ll>(20 * N + rng() % 20)});
+    }
+    for (std::size_t s : {0, 7, 60})
+    {
+        auto res = gcl::spfa(g, s);
+        EXPECT_FALSE(res.negative_cycle_exist);
+        EXPECT_TRUE(res.negative_cycle.empty());
+        EXPECT_EQ(res.dist, gcl::bellman_ford(g, s).dist);
+    }
+}
+
+TEST(SPFA, ExtractsCycleAndMarksNegativeInfinity)
+{
+    using ll = long long;
+    constexpr ll NEG_INF = std::numeric_limits<ll>::lowest();
+    constexpr ll INF = std::numeric_limits<ll>::max();
+
+    gcl::WGraph<ll> g(6);
+    g[0].push_back({1, 1});
+    g[1].push_back({2, 1});
+    g[2].push_back({3, 1});
+    g[3].push_back({1, -5}); // 1 -> 2 -> 3 -> 1 が負閉路
+    g[3].push_back({4, 2});
+    g[0].push_back({5, 3}); // 5 は負閉路から到達不能
+
+    auto res = gcl::spfa(g, 0);
+    EXPECT_TRUE(res.negative_cycle_exist);
+    EXPECT_EQ(res.dist, (std::vector<ll>{0, NEG_INF, NEG_INF, NEG_INF, NEG_INF, 3}));
+
+    auto cycle = res.negative_cycle;
+    ASSERT_EQ(cycle.size(), std::size_t{3});
+    std::rotate(cycle.begin(), std::min_element(cycle.begin(), cycle.end()), cycle.end());
+    EXPECT_EQ(cycle, (std::vector<std::size_t>{1, 2, 3}));
+
+    auto unreachable = gcl::spfa(g, 5);
+    EXPECT_FALSE(unreachable.negative_cycle_exist);
+    EXPECT_EQ(unreachable.dist[1], INF);
+}
+
+TEST(SPFA, RandomGraphsWithNegativeCycles)
+{
+    using ll = long long;
+    constexpr ll NEG_INF = std::numeric_limits<ll>::lowest();
+    std::mt19937 rng(77);
+    for (int iter = 0; iter < 50; iter++)
+    {
+        const std::size_t N = 5 + rng() % 40;
+        // 多重辺を作らないので、閉路上の隣り合う頂点の間の辺は一意に決まる
+        gcl::WGraph<ll> g(N);
+        std::vector<std::vector<bool>> has_edge(N, std::vector<bool>(N, false));
+        for (std::size_t i = 0; i < 2 * N; i++)
+        {
+            const std::size_t u = rng() % N, v = rng() % N;
+            const auto w = static_cast<ll>(rng() % 30) - 6;
+            if (has_edge[u][v])
+                continue;
+            has_edge[u][v] = true;
+            g[u].push_back({v, w});
+        }
+
+        auto res = gcl::spfa(g, 0);
+        auto expected = naive_bellman_ford_with_neg_inf(g, 0);
+        EXPECT_EQ(res.dist, expected);
+
+        bool has_neg_inf = std::count(expected.begin(), expected.end(), NEG_INF) > 0;
+        EXPECT_EQ(res.negative_cycle_exist, has_neg_inf);
+        if (!has_neg_inf)
+            continue;
+
+        // 取り出した閉路が実際に負閉路であることを確認する
+        const auto &cycle = res.negative_cycle;
+        ASSERT_FALSE(cycle.empty());
+        ll total = 0;
+        for (std::size_t i = 0; i < cycle.size(); i++)
+        {
+            auto u = cycle[i], v = cycle[(i + 1) % cycle.size()];
+            ASSERT_TRUE(has_edge[u][v]);
+            for (const auto &e : g[u])
+            {
+                if (e.to == v)
+                    total += e.weight;
+            }
+        }
+        EXPECT_LT(total, 0);
+    }
+}
+
+TEST(SPFA, UnsignedWeights)
+{
+    // 符号なしの重みでは`lowest()`が 0 になるが、始点を負の無限大と混同しない
+    using ull = unsigned long long;
+    gcl::WGraph<ull> g(4);
+    g[0].push_back({1, 2});
+    g[1].push_back({2, 3});
+    auto res = gcl::spfa(g, 0);
+    EXPECT_FALSE(res.negative_cycle_exist);
+    EXPECT_EQ(res.dist, (std::vector<ull>{0, 2, 5, std::numeric_limits<ull>::max()}));
+    EXPECT_EQ(res.dist, gcl::bellman_ford(g, 0).dist);
+}
+
+TEST(Johnson, MatchesBellmanFordFromEverySource)
+{
+    using ll = long long;
+    std::mt19937 rng(11);
+    for (int iter = 0; iter < 5; iter++)
+    {
+        const std::size_t N = 30 + rng() % 30;
+        // 重み`base + p[u] - p[v]`（`base >= 0`）の辺は負閉路を作らない
+        std::vector<ll> p(N);
+        for (auto &x : p)
+            x = static_cast<ll>(rng() % 100);
+        gcl::WGraph<ll> g(N);
+        for (std::size_t i = 0; i < 4 * N; i++)
+        {
+            std::size_t u = rng() % N, v = rng() % N;
+            g[u].push_back({v, static_cast<ll>(rng() % 20) + p[u] - p[v]});
+        }
+
+        std::vector<ll> matrix(N * N);
+        ASSERT_TRUE(gcl::johnson(g, matrix, 1 + iter % 3));
+        for (std::size_t u = 0; u < N; u++)
+        {
+            auto expected = gcl::bellman_ford(g, u).dist;
+            for (std::size_t v = 0; v < N; v++)
+                EXPECT_EQ(matrix[u * N + v], expected[v]);
+        }
+    }
+}
+
+TEST(Johnson, DetectsNegativeCycleAndStreams)
+{
+    using ll = long long;
+    gcl::WGraph<ll> g(3);
+    g[0].push_back({1, 2});
+    g[1].push_back({2, -1});
+
+    std::vector<ll> row_sum(3);
+    ASSERT_TRUE(gcl::johnson(
+        g, [&](std::size_t u, const std::vector<ll> &dist)
+        { row_sum[u] = dist[2]; }, 2));
+    EXPECT_EQ(row_sum, (std::vector<ll>{1, -1, 0}));
+
+    g[2].push_back({1, 0}); // 1 -> 2 -> 1 が負閉路（始点によらず検出する）
+    std::vector<ll> matrix(9, 42);
+    EXPECT_FALSE(gcl::johnson(g, matrix));
+    EXPECT_EQ(matrix, std::vector<ll>(9, 42));
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <vector>
+#include "../data-structure/sparse_table.hpp"
+
+TEST(SparseTable, MinMatchesNaive)
+{
+    std::vector<int> v(100);
+    for (std::size_t i = 0; i < v.size(); i++)
+        v[i] = static_cast<int>((i * 37) % 101);
+    gcl::SparseTable<int> table(v);
+    EXPECT_EQ(table.size(), v.size());
+    for (std::size_t l = 0; l < v.size(); l++)
+    {
+        for (auto r = l + 1; r <= v.size(); r++)
+            EXPECT_EQ(table.prod(l, r), *std::min_element(v.begin() + static_cast<std::ptrdiff_t>(l), v.begin() + static_cast<std::ptrdiff_t>(r)));
+        EXPECT_EQ(table.get(l), v[l]);
+    }
+}
+
+TEST(SparseTable, CustomCompare)
+{
+    std::vector<int> v = {3, 9, 2, 7, 5};
+    gcl::SparseTable<int, std::greater<>> table(v);
+    EXPECT_EQ(table.prod(0, 5), 9);
+    EXPECT_EQ(table.prod(2, 5), 7);
+    EXPECT_EQ(table.prod(4, 5), 5);
+}
+
+TEST(SparseTable, NonDefaultConstructible)
+{
+    // コピーできるがデフォルト構築できない型
+    struct Value
+    {
+        explicit Value(int x) : x(x) {}
+        int x;
+        bool operator<(const Value &other) const { return x < other.x; }
+    };
+    static_assert(!std::default_initializable<Value>);
+    std::vector<Value> v;
+    for (int x : {4, 8, 1, 6, 3, 7})
+        v.emplace_back(x);
+    gcl::SparseTable<Value> table(v);
+    EXPECT_EQ(table.prod(0, 6).x, 1);
+    EXPECT_EQ(table.prod(3, 6).x, 3);
+    EXPECT_EQ(table.prod(1, 2).x, 8);
+}
@@ -0,0 +1,399 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+#include "../data-structure/treap.hpp"
+
+namespace
+{
+    // 区間和（長さも持つ）
+    struct SumMonoid
+    {
+        struct value_type
+        {
+            long long sum = 0, len = 0;
+        };
+        static value_type identity() { return {}; }
+        static value_type op(const value_type &a, const value_type &b) { return {a.sum + b.sum, a.len + b.len}; }
+    };
+
+    // 区間への一次関数`x -> a * x + b`の作用
+    struct AffineAction
+    {
+        struct value_type
+        {
+            long long a = 1, b = 0;
+        };
+        static value_type identity() { return {}; }
+        static value_type op(const value_type &f, const value_type &g) { return {f.a * g.a, f.a * g.b + f.b}; }
+        static SumMonoid::value_type act(const value_type &f, const SumMonoid::value_type &x) { return {f.a * x.sum + f.b * x.len, x.len}; }
+    };
+
+    struct MinMonoid
+    {
+        using value_type = int;
+        static value_type identity() { return std::numeric_limits<int>::max(); }
+        static value_type op(value_type a, value_type b) { return std::min(a, b); }
+    };
+
+    SumMonoid::value_type leaf(long long x) { return {x, 1}; }
+
+    // 一次関数の合成（非可換）。`op(f, g)`は`f`の後に`g`を施す関数
+    struct CompositeMonoid
+    {
+        static constexpr long long MOD = 998244353;
+        struct value_type
+        {
+            long long a = 1, b = 0;
+            bool operator==(const value_type &) const = default;
+        };
+        static value_type identity() { return {}; }
+        static value_type op(const value_type &f, const value_type &g) { return {f.a * g.a % MOD, (f.b * g.a + g.b) % MOD}; }
+    };
+
+    CompositeMonoid::value_type fold(const std::vector<CompositeMonoid::value_type> &v, std::size_t l, std::size_t r)
+    {
+        auto acc = CompositeMonoid::identity();
+        for (auto i = l; i < r; i++)
+            acc = CompositeMonoid::op(acc, v[i]);
+        return acc;
+    }
+}
+
+TEST(Treap, BuildAndGet)
+{
+    gcl::Treap<MinMonoid> treap;
+    std::vector<int> v(1000);
+    std::iota(v.begin(), v.end(), 0);
+    auto root = treap.build(v);
+    EXPECT_EQ(treap.size(root), v.size());
+    EXPECT_EQ(treap.prod(root), 0);
+    EXPECT_EQ(treap.to_vector(root), v);
+    for (std::size_t i = 0; i < v.size(); i += 37)
+        EXPECT_EQ(treap.get(root, i), v[i]);
+    EXPECT_EQ(treap.build(std::vector<int>{}), gcl::Treap<MinMonoid>::NIL);
+}
+
+TEST(Treap, SplitMerge)
+{
+    gcl::Treap<MinMonoid> treap;
+    auto root = treap.build(std::vector<int>{5, 3, 8, 1, 9, 2});
+    auto [a, b] = treap.split(root, 2);
+    EXPECT_EQ(treap.to_vector(a), (std::vector<int>{5, 3}));
+    EXPECT_EQ(treap.to_vector(b), (std::vector<int>{8, 1, 9, 2}));
+    EXPECT_EQ(treap.prod(a), 3);
+    EXPECT_EQ(treap.prod(b), 1);
+    root = treap.merge(b, a);
+    EXPECT_EQ(treap.to_vector(root), (std::vector<int>{8, 1, 9, 2, 5, 3}));
+}
+
+TEST(Treap, SequenceOperationsMatchNaive)
+{
+    gcl::Treap<SumMonoid, AffineAction> treap;
+    std::vector<long long> naive(200);
+    for (std::size_t i = 0; i < naive.size(); i++)
+        naive[i] = static_cast<long long>(i % 13);
+    std::vector<SumMonoid::value_type> init;
+    for (auto x : naive)
+        init.push_back(leaf(x));
+    auto root = treap.build(init);
+
+    std::mt19937 rng(12345);
+    for (int it = 0; it < 3000; it++)
+    {
+        const auto n = naive.size();
+        std::size_t l = rng() % (n + 1), r = rng() % (n + 1);
+        if (l > r)
+            std::swap(l, r);
+        switch (rng() % 6)
+        {
+        case 0:
+        {
+            const long long a = static_cast<long long>(rng() % 3) - 1, b = static_cast<long long>(rng() % 11) - 5;
+            treap.apply(root, l, r, {a, b});
+            for (auto i = l; i < r; i++)
+                naive[i] = a * naive[i] + b;
+            break;
+        }
+        case 1:
+            treap.reverse(root, l, r);
+            std::reverse(naive.begin() + static_cast<std::ptrdiff_t>(l), naive.begin() + static_cast<std::ptrdiff_t>(r));
+            break;
+        case 2:
+        {
+            const long long val = static_cast<long long>(rng() % 100);
+            treap.insert(root, l, leaf(val));
+            naive.insert(naive.begin() + static_cast<std::ptrdiff_t>(l), val);
+            break;
+        }
+        case 3:
+            if (l < n)
+            {
+                EXPECT_EQ(treap.erase(root, l).sum, naive[l]);
+                naive.erase(naive.begin() + static_cast<std::ptrdiff_t>(l));
+            }
+            break;
+        case 4:
+            if (l < n)
+            {
+                treap.set(root, l, leaf(-7));
+                naive[l] = -7;
+            }
+            break;
+        default:
+            break;
+        }
+        l = std::min(l, naive.size());
+        r = std::min(std::max(l, r), naive.size());
+        const auto got = treap.prod(root, l, r);
+        EXPECT_EQ(got.sum, std::accumulate(naive.begin() + static_cast<std::ptrdiff_t>(l), naive.begin() + static_cast<std::ptrdiff_t>(r), 0LL));
+        EXPECT_EQ(got.len, static_cast<long long>(r - l));
+    }
+    ASSERT_EQ(treap.size(root), naive.size());
+    for (std::size_t i = 0; i < naive.size(); i++)
+        EXPECT_EQ(treap.get(root, i).sum, naive[i]);
+    EXPECT_EQ(treap.node_count(), naive.size());
+}
+
+TEST(Treap, ReverseWithNonCommutativeMonoid)
+{
+    gcl::Treap<CompositeMonoid> treap;
+    std::mt19937 rng(12345);
+    std::vector<CompositeMonoid::value_type> naive(200);
+    for (auto &f : naive)
+        f = {static_cast<long long>(rng() % 100), static_cast<long long>(rng() % 100)};
+    auto root = treap.build(naive);
+    for (int it = 0; it < 2000; it++)
+    {
+        const auto n = naive.size();
+        std::size_t l = rng() % (n + 1), r = rng() % (n + 1);
+        if (l > r)
+            std::swap(l, r);
+        if (rng() % 2 == 0)
+        {
+            treap.reverse(root, l, r);
+            std::reverse(naive.begin() + static_cast<std::ptrdiff_t>(l), naive.begin() + static_cast<std::ptrdiff_t>(r));
+        }
+        EXPECT_EQ(treap.prod(root, l, r), fold(naive, l, r));
+        EXPECT_EQ(treap.prod(root), fold(naive, 0, n));
+    }
+    EXPECT_EQ(treap.to_vector(root), naive);
+}
+
+TEST(Treap, OrderedSetMatchesMultiset)
+{
+    gcl::Treap<MinMonoid> treap;
+    std::multiset<int> naive;
+    std::vector<int> init = {1, 1, 4, 10, 20};
+    auto root = treap.build(init);
+    naive.insert(init.begin(), init.end());
+
+    std::mt19937 rng(12345);
+    for (int it = 0; it < 3000; it++)
+    {
+        const int val = static_cast<int>(rng() % 50);
+        if (rng() % 3 == 0)
+        {
+            const auto found = naive.find(val);
+            EXPECT_EQ(treap.erase_value(root, val), found != naive.end());
+            if (found != naive.end())
+                naive.erase(found);
+        }
+        else
+        {
+            treap.insert_sorted(root, val);
+            naive.insert(val);
+        }
+        EXPECT_EQ(treap.lower_bound(root, val), static_cast<std::size_t>(std::distance(naive.begin(), naive.lower_bound(val))));
+        EXPECT_EQ(treap.upper_bound(root, val), static_cast<std::size_t>(std::distance(naive.begin(), naive.upper_bound(val))));
+    }
+    EXPECT_EQ(treap.to_vector(root), std::vector<int>(naive.begin(), naive.end()));
+    EXPECT_EQ(treap.prod(root), naive.empty() ? MinMonoid::identity() : *naive.begin());
+
+    auto [less, rest] = treap.split_lower(root, 25);
+    EXPECT_EQ(treap.size(less), static_cast<std::size_t>(std::distance(naive.begin(), naive.lower_bound(25))));
+    root = treap.merge(less, rest);
+}
+
+TEST(Treap, ReleaseReusesNodes)
+{
+    gcl::Treap<MinMonoid> treap(100);
+    auto a = treap.build(std::vector<int>(100, 1));
+    EXPECT_EQ(treap.node_count(), 100u);
+    treap.release(a);
+    EXPECT_EQ(treap.node_count(), 0u);
+    auto b = treap.build(std::vector<int>(50, 2));
+    EXPECT_EQ(treap.node_count(), 50u);
+    EXPECT_EQ(treap.to_vector(b), std::vector<int>(50, 2));
+}
+
+TEST(PersistentTreap, VersionsAreIndependent)
+{
+    gcl::PersistentTreap<SumMonoid, AffineAction> treap;
+    std::vector<long long> init(30);
+    std::iota(init.begin(), init.end(), 0LL);
+    std::vector<SumMonoid::value_type> leaves;
+    for (auto v : init)
+        leaves.push_back(leaf(v));
+    std::vector<std::vector<long long>> naive{init};
+    std::vector<gcl::PersistentTreap<SumMonoid, AffineAction>::node_type> roots{treap.build(leaves)};
+
+    std::mt19937 rng(12345);
+    for (int it = 0; it < 1500; it++)
+    {
+        // 過去の版を1つ選んで更新し、新しい版として追加する
+        const auto base = rng() % roots.size();
+        auto cur = naive[base];
+        auto root = roots[base];
+        const auto n = cur.size();
+        std::size_t l = rng() % (n + 1), r = rng() % (n + 1);
+        if (l > r)
+            std::swap(l, r);
+        switch (rng() % 5)
+        {
+        case 0:
+        {
+            const long long a = static_cast<long long>(rng() % 3) - 1, b = static_cast<long long>(rng() % 11) - 5;
+            root = treap.apply(root, l, r, {a, b});
+            for (auto i = l; i < r; i++)
+                cur[i] = a * cur[i] + b;
+            break;
+        }
+        case 1:
+            root = treap.reverse(root, l, r);
+            std::reverse(cur.begin() + static_cast<std::ptrdiff_t>(l), cur.begin() + static_cast<std::ptrdiff_t>(r));
+            break;
+        case 2:
+        {
+            const long long val = static_cast<long long>(rng() % 100);
+            root = treap.insert(root, l, leaf(val));
+            cur.insert(cur.begin() + static_cast<std::ptrdiff_t>(l), val);
+            break;
+        }
+        case 3:
+            if (l < n)
+            {
+                root = treap.erase(root, l);
+                cur.erase(cur.begin() + static_cast<std::ptrdiff_t>(l));
+            }
+            break;
+        default:
+            if (l < n)
+            {
+                root = treap.set(root, l, leaf(-3));
+                cur[l] = -3;
+            }
+            break;
+        }
+        roots.push_back(root);
+        naive.push_back(cur);
+
+        // 任意の版の区間和・一点取得が変わっていないことを確認する
+        const auto check = rng() % roots.size();
+        const auto m = naive[check].size();
+        std::size_t ql = rng() % (m + 1), qr = rng() % (m + 1);
+        if (ql > qr)
+            std::swap(ql, qr);
+        const auto got = treap.prod(roots[check], ql, qr);
+        EXPECT_EQ(got.sum, std::accumulate(naive[check].begin() + static_cast<std::ptrdiff_t>(ql), naive[check].begin() + static_cast<std::ptrdiff_t>(qr), 0LL));
+        EXPECT_EQ(got.len, static_cast<long long>(qr - ql));
+        if (ql < m)
+        {
+            EXPECT_EQ(treap.get(roots[check], ql).sum, naive[check][ql]);
+        }
+    }
+    for (std::size_t v = 0; v < roots.size(); v += 97)
+    {
+        std::vector<long long> got;
+        for (const auto &e : treap.to_vector(roots[v]))
+            got.push_back(e.sum);
+        EXPECT_EQ(got, naive[v]);
+    }
+}
+
+TEST(PersistentTreap, ReverseWithNonCommutativeMonoid)
+{
+    gcl::PersistentTreap<CompositeMonoid> treap;
+    std::mt19937 rng(12345);
+    std::vector<CompositeMonoid::value_type> init(200);
+    for (auto &f : init)
+        f = {static_cast<long long>(rng() % 100), static_cast<long long>(rng() % 100)};
+    std::vector<gcl::PersistentTreap<CompositeMonoid>::node_type> roots{treap.build(init)};
+    std::vector<std::vector<CompositeMonoid::value_type>> naive{init};
+    for (int it = 0; it < 1000; it++)
+    {
+        const auto base = rng() % roots.size();
+        auto cur = naive[base];
+        std::size_t l = rng() % (cur.size() + 1), r = rng() % (cur.size() + 1);
+        if (l > r)
+            std::swap(l, r);
+        roots.push_back(treap.reverse(roots[base], l, r));
+        std::reverse(cur.begin() + static_cast<std::ptrdiff_t>(l), cur.begin() + static_cast<std::ptrdiff_t>(r));
+        naive.push_back(cur);
+
+        // 反転を重ねた版の部分区間も、古い版の区間も正しく集約できる
+        const auto check = rng() % roots.size();
+        const auto m = naive[check].size();
+        std::size_t ql = rng() % (m + 1), qr = rng() % (m + 1);
+        if (ql > qr)
+            std::swap(ql, qr);
+        EXPECT_EQ(treap.prod(roots[check], ql, qr), fold(naive[check], ql, qr));
+        EXPECT_EQ(treap.prod(roots.back()), fold(naive.back(), 0, naive.back().size()));
+    }
+    for (std::size_t v = 0; v < roots.size(); v += 97)
+        EXPECT_EQ(treap.to_vector(roots[v]), naive[v]);
+}
+
+TEST(PersistentTreap, SelfConcatenation)
+{
+    gcl::PersistentTreap<MinMonoid> treap;
+    auto root = treap.build(std::vector<int>{3, 1, 4});
+    // 同じ版を繰り返し連結して長さ 3 * 2^10 の列を作る
+    for (int i = 0; i < 10; i++)
+        root = treap.merge(root, root);
+    ASSERT_EQ(treap.size(root), 3u << 10);
+    EXPECT_EQ(treap.get(root, 3000), (std::vector<int>{3, 1, 4})[3000 % 3]);
+    EXPECT_EQ(treap.prod(root, 2, 3), 4);
+    EXPECT_EQ(treap.prod(root), 1);
+    // 共有しているので節点数は要素数よりずっと少ない
+    EXPECT_LT(treap.node_count(), 3u << 10);
+}
+
+TEST(PersistentTreap, CompactKeepsRequestedVersions)
+{
+    gcl::PersistentTreap<MinMonoid> treap;
+    std::vector<int> base(1000);
+    std::iota(base.begin(), base.end(), 0);
+    auto root = treap.build(base);
+    std::vector<gcl::PersistentTreap<MinMonoid>::node_type> keep;
+    std::vector<std::vector<int>> expected;
+    auto cur = base;
+    for (int it = 0; it < 2000; it++)
+    {
+        const auto pos = static_cast<std::size_t>(it * 7919) % cur.size();
+        root = treap.set(root, pos, -it);
+        cur[pos] = -it;
+        if (it % 500 == 0)
+        {
+            keep.push_back(root);
+            expected.push_back(cur);
+        }
+    }
+    keep.push_back(root);
+    expected.push_back(cur);
+
+    const auto before = treap.node_count();
+    treap.compact(keep);
+    EXPECT_LT(treap.node_count(), before);
+    for (std::size_t i = 0; i < keep.size(); i++)
+        EXPECT_EQ(treap.to_vector(keep[i]), expected[i]);
+
+    // 詰め直した後も更新できる
+    auto updated = treap.insert(keep.back(), 0, -5000);
+    EXPECT_EQ(treap.prod(updated), -5000);
+    EXPECT_EQ(treap.to_vector(keep.back()), expected.back());
+}
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <random>
+#include <string>
 #include "../data-structure/unionfind.hpp"
 
 TEST(UnionFind, Unite)
@@ -65,4 +67,118 @@ TEST(UnionFind, Same)
     // 孤立点
     EXPECT_EQ(uf.same(0, 4), false);
     EXPECT_EQ(uf.same(4, 4), true);
-}
\ No newline at end of file
+}
+
+TEST(UnionFind, ManyElements)
+{
+    const auto size = std::size_t{2'000'000};
+    gcl::UnionFind uf(size);
+    gcl::CompactUnionFind<> compact(size);
+    for (std::size_t i = 1; i < size; i++)
+    {
+        EXPECT_TRUE(uf.unite(i, i - 1));
+        EXPECT_TRUE(compact.unite(i, i - 1));
+    }
+    EXPECT_EQ(uf.size(size - 1), size);
+    EXPECT_EQ(uf.find(size - 1), uf.find(0));
+    EXPECT_EQ(compact.size(0), size);
+    EXPECT_EQ(compact.find(size - 1), compact.find(0));
+}
+
+TEST(CompactUnionFind, MatchesUnionFind)
+{
+    static_assert(sizeof(gcl::CompactUnionFind<std::int32_t>) == sizeof(std::vector<std::int32_t>));
+    const auto size = std::size_t{200};
+    gcl::UnionFind uf(size);
+    gcl::CompactUnionFind<std::int32_t> compact32(size);
+    gcl::CompactUnionFind<std::int16_t> compact16(size);
+    std::uint64_t x = 88172645463325252ull;
+    for (int it = 0; it < 1000; it++)
+    {
+        x ^= x << 7;
+        x ^= x >> 9;
+        const auto a = x % size, b = (x >> 20) % size;
+        const bool united = uf.unite(a, b);
+        EXPECT_EQ(compact32.unite(a, b), united);
+        EXPECT_EQ(compact16.unite(a, b), united);
+        const auto c = (x >> 40) % size;
+        // 代表元の選び方（同サイズなら左）も一致する
+        EXPECT_EQ(compact32.find(c), uf.find(c));
+        EXPECT_EQ(compact16.find(c), uf.find(c));
+        EXPECT_EQ(compact32.size(c), uf.size(c));
+        EXPECT_EQ(compact16.same(a, c), uf.same(a, c));
+    }
+}
+
+TEST(RollbackUnionFind, SnapshotAndRollback)
+{
+    gcl::RollbackUnionFind uf(5);
+    EXPECT_TRUE(uf.unite(0, 1));
+    const auto state = uf.snapshot();
+    EXPECT_TRUE(uf.unite(2, 3));
+    EXPECT_FALSE(uf.unite(3, 2)); // 履歴には積まれない
+    EXPECT_TRUE(uf.unite(1, 3));
+    EXPECT_EQ(uf.size(2), std::size_t{4});
+    EXPECT_EQ(uf.find(3), std::size_t{0});
+
+    uf.undo(); // unite(1, 3) を取り消す
+    EXPECT_FALSE(uf.same(0, 2));
+    EXPECT_TRUE(uf.same(2, 3));
+    EXPECT_EQ(uf.size(0), std::size_t{2});
+
+    uf.rollback(state);
+    EXPECT_FALSE(uf.same(2, 3));
+    EXPECT_TRUE(uf.same(0, 1));
+    EXPECT_EQ(uf.size(3), std::size_t{1});
+    EXPECT_EQ(uf.snapshot(), state);
+
+    uf.rollback(0);
+    EXPECT_FALSE(uf.same(0, 1));
+}
+
+TEST(WeightedUnionFind, DiffAndContradiction)
+{
+    gcl::WeightedUnionFind<long long> uf(4);
+    EXPECT_TRUE(uf.unite(0, 1, 5));  // x1 - x0 = 5
+    EXPECT_TRUE(uf.unite(1, 2, -3)); // x2 - x1 = -3
+    EXPECT_EQ(uf.diff(0, 2), 2);
+    EXPECT_EQ(uf.diff(2, 0), -2);
+    EXPECT_TRUE(uf.unite(2, 0, -2)); // 既存の制約と一致
+    EXPECT_FALSE(uf.unite(0, 2, 3)); // 矛盾
+    EXPECT_EQ(uf.diff(0, 2), 2);
+    EXPECT_FALSE(uf.same(0, 3));
+    EXPECT_EQ(uf.size(1), std::size_t{3});
+    EXPECT_EQ(uf.find(2), std::size_t{0});
+}
+
+TEST(WeightedUnionFind, MatchesHiddenPotentials)
+{
+    static_assert(gcl::PotentialLike<long long>);
+    static_assert(!gcl::PotentialLike<std::string>);
+    const std::size_t size = 300;
+    std::mt19937 rng(12345);
+    std::vector<long long> potential(size);
+    for (auto &p : potential)
+        p = static_cast<long long>(rng() % 1000);
+
+    gcl::WeightedUnionFind<long long> uf(size);
+    gcl::UnionFind plain(size);
+    for (int it = 0; it < 2000; it++)
+    {
+        const auto a = rng() % size, b = rng() % size;
+        const auto w = potential[b] - potential[a];
+        // 正しい制約は常に受け入れられ、ずらした制約は同じ集合なら拒否される
+        if (plain.same(a, b))
+        {
+            EXPECT_FALSE(uf.unite(a, b, w + 1));
+        }
+        EXPECT_TRUE(uf.unite(a, b, w));
+        plain.unite(a, b);
+        const auto c = rng() % size, d = rng() % size;
+        EXPECT_EQ(uf.same(c, d), plain.same(c, d));
+        if (plain.same(c, d))
+        {
+            EXPECT_EQ(uf.diff(c, d), potential[d] - potential[c]);
+        }
+    }
+}